@@ -0,0 +1,450 @@
+/*
+ * Batch Abstract Factory Example
+ * ------------------------------
+ * With AbstractFactory.cpp, a kitchen handling a burst of orders calls createBurger() and
+ * createGarlicBread() once per item: a virtual call, a string comparison chain and a heap
+ * allocation each, followed by a virtual prepare() on an object somewhere on the heap.
+ *
+ * MealFactory here adds bulk APIs next to the per-item ones:
+ *     createBurgers(span<const BurgerType> orders, ProductBatch<Burger>& out)
+ *     createGarlicBreads(span<const GarlicBreadType> orders, ProductBatch<GarlicBread>& out)
+ *   - Orders are grouped by product type. Each concrete type gets its own contiguous vector
+ *     inside the batch, sized once per call (no per-item allocation).
+ *   - out[i] still gives the product for orders[i], so callers see the original order. It is
+ *     kept as (group, index), so appending to a filled batch, even from another factory,
+ *     never invalidates earlier products.
+ *   - out.prepareAll() runs prepare() group by group over each homogeneous vector. Concrete
+ *     products are `final`, so inside a group the call is resolved statically.
+ *   - A batch keeps its capacity across clear(), so a kitchen reusing one batch per burst
+ *     stops allocating altogether after warm-up.
+ *
+ * main() runs the usual demo, then processes 1M mixed orders (a burger and a garlic bread
+ * each) with the per-item path and with the batch path.
+ *
+ * Build: g++ -std=c++20 -O2 BatchMealFactory.cpp
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <typeinfo>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+enum class BurgerType { Basic, Standard, Premium };
+enum class GarlicBreadType { Basic, Cheese };
+
+// Product 1 --> Burger
+class Burger {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;  // Pure virtual function
+    virtual ~Burger() {}  // Virtual destructor
+
+    void serve() const {
+        cout << description << " (" << calories << " kcal)" << endl;
+    }
+
+    int getCalories() const { return calories; }
+};
+
+class BasicBurger final : public Burger {
+public:
+    void prepare() override { description = "Basic Burger with bun, patty, and ketchup"; calories = 450; }
+};
+
+class StandardBurger final : public Burger {
+public:
+    void prepare() override { description = "Standard Burger with bun, patty, cheese, and lettuce"; calories = 600; }
+};
+
+class PremiumBurger final : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 850;
+    }
+};
+
+class BasicWheatBurger final : public Burger {
+public:
+    void prepare() override { description = "Basic Wheat Burger with bun, patty, and ketchup"; calories = 420; }
+};
+
+class StandardWheatBurger final : public Burger {
+public:
+    void prepare() override { description = "Standard Wheat Burger with bun, patty, cheese, and lettuce"; calories = 570; }
+};
+
+class PremiumWheatBurger final : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Wheat Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 810;
+    }
+};
+
+// Product 2 --> GarlicBread
+class GarlicBread {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;
+    virtual ~GarlicBread() {}
+
+    void serve() const {
+        cout << description << " (" << calories << " kcal)" << endl;
+    }
+
+    int getCalories() const { return calories; }
+};
+
+class BasicGarlicBread final : public GarlicBread {
+public:
+    void prepare() override { description = "Basic Garlic Bread with butter and garlic"; calories = 300; }
+};
+
+class CheeseGarlicBread final : public GarlicBread {
+public:
+    void prepare() override { description = "Cheese Garlic Bread with extra cheese and butter"; calories = 420; }
+};
+
+class BasicWheatGarlicBread final : public GarlicBread {
+public:
+    void prepare() override { description = "Basic Wheat Garlic Bread with butter and garlic"; calories = 280; }
+};
+
+class CheeseWheatGarlicBread final : public GarlicBread {
+public:
+    void prepare() override { description = "Cheese Wheat Garlic Bread with extra cheese and butter"; calories = 400; }
+};
+
+// Products of one bulk call, stored contiguously per concrete type.
+template <typename Base>
+class ProductBatch {
+private:
+    struct GroupBase {
+        virtual ~GroupBase() {}
+        virtual Base& at(size_t i) = 0;
+        virtual void prepareAll() = 0;
+        virtual void clear() = 0;
+    };
+
+    template <typename T>
+    struct Group : GroupBase {
+        vector<T> items;
+
+        Base& at(size_t i) override { return items[i]; }
+
+        void prepareAll() override {
+            for (T& item : items) {
+                item.prepare();   // T is final: a direct, inlinable call
+            }
+        }
+
+        void clear() override { items.clear(); }
+    };
+
+    // Where a product lives. Indices rather than pointers, so a group vector may reallocate
+    // when a later call appends to it.
+    struct Ref {
+        uint32_t group;
+        uint32_t index;
+    };
+
+    vector<unique_ptr<GroupBase>> groups;   // one per concrete type, in first-use order
+    vector<Ref> ordered;                    // ordered[i] = product for orders[i]
+
+public:
+    // The group index for concrete type T, created on first use. Groups are never replaced,
+    // so products from different factories can share one batch.
+    template <typename T>
+    size_t groupFor() {
+        for (size_t g = 0; g < groups.size(); g++) {
+            if (typeid(*groups[g]) == typeid(Group<T>)) {
+                return g;
+            }
+        }
+        groups.push_back(make_unique<Group<T>>());
+        return groups.size() - 1;
+    }
+
+    template <typename T>
+    vector<T>& items(size_t group) {
+        return static_cast<Group<T>&>(*groups[group]).items;
+    }
+
+    // Room for `n` more products in the original order.
+    void reserveOrdered(size_t n) {
+        ordered.resize(ordered.size() + n);
+    }
+
+    void place(size_t i, size_t group, size_t index) {
+        ordered[i] = Ref{uint32_t(group), uint32_t(index)};
+    }
+
+    size_t size() const { return ordered.size(); }
+
+    Base& operator[](size_t i) {
+        Ref r = ordered[i];
+        return groups[r.group]->at(r.index);
+    }
+
+    void prepareAll() {
+        for (auto& g : groups) {
+            g->prepareAll();
+        }
+    }
+
+    // Destroys the products but keeps the memory for the next burst.
+    void clear() {
+        for (auto& g : groups) {
+            g->clear();
+        }
+        ordered.clear();
+    }
+};
+
+// Factory and its concretions
+class MealFactory {
+protected:
+    // Fills `out` from `orders`: one pass per product type over the orders, each appending to
+    // that type's contiguous vector. Ts... are the concrete products in enum order.
+    template <typename Base, typename Kind, typename... Ts>
+    static void fillBatch(span<const Kind> orders, ProductBatch<Base>& out) {
+        size_t first = out.size();
+        out.reserveOrdered(orders.size());
+        fillGroups<Base, Kind, Ts...>(orders, out, first, index_sequence_for<Ts...>());
+    }
+
+private:
+    template <typename Base, typename Kind, typename... Ts, size_t... I>
+    static void fillGroups(span<const Kind> orders, ProductBatch<Base>& out, size_t first, index_sequence<I...>) {
+        (fillGroup<Base, Kind, Ts, I>(orders, out, first), ...);
+    }
+
+    template <typename Base, typename Kind, typename T, size_t Slot>
+    static void fillGroup(span<const Kind> orders, ProductBatch<Base>& out, size_t first) {
+        size_t count = 0;
+        for (Kind k : orders) {
+            count += size_t(k) == Slot;
+        }
+        if (count == 0) {
+            return;
+        }
+        size_t group = out.template groupFor<T>();
+        vector<T>& items = out.template items<T>(group);
+        if (items.capacity() < items.size() + count) {
+            items.reserve(max(items.size() + count, items.capacity() * 2));
+        }
+        for (size_t i = 0; i < orders.size(); i++) {
+            if (size_t(orders[i]) == Slot) {
+                out.place(first + i, group, items.size());
+                items.emplace_back();
+            }
+        }
+    }
+
+public:
+    virtual Burger* createBurger(string& type) = 0;
+    virtual GarlicBread* createGarlicBread(string& type) = 0;
+
+    virtual void createBurgers(span<const BurgerType> orders, ProductBatch<Burger>& out) = 0;
+    virtual void createGarlicBreads(span<const GarlicBreadType> orders, ProductBatch<GarlicBread>& out) = 0;
+
+    virtual ~MealFactory() {}
+};
+
+class SinghBurger : public MealFactory {
+public:
+    Burger* createBurger(string& type) override {
+        if (type == "basic") {
+            return new BasicBurger();
+        } else if (type == "standard") {
+            return new StandardBurger();
+        } else if (type == "premium") {
+            return new PremiumBurger();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    GarlicBread* createGarlicBread(string& type) override {
+        if (type == "basic") {
+            return new BasicGarlicBread();
+        } else if (type == "cheese") {
+            return new CheeseGarlicBread();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+
+    void createBurgers(span<const BurgerType> orders, ProductBatch<Burger>& out) override {
+        fillBatch<Burger, BurgerType, BasicBurger, StandardBurger, PremiumBurger>(orders, out);
+    }
+
+    void createGarlicBreads(span<const GarlicBreadType> orders, ProductBatch<GarlicBread>& out) override {
+        fillBatch<GarlicBread, GarlicBreadType, BasicGarlicBread, CheeseGarlicBread>(orders, out);
+    }
+};
+
+class KingBurger : public MealFactory {
+public:
+    Burger* createBurger(string& type) override {
+        if (type == "basic") {
+            return new BasicWheatBurger();
+        } else if (type == "standard") {
+            return new StandardWheatBurger();
+        } else if (type == "premium") {
+            return new PremiumWheatBurger();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    GarlicBread* createGarlicBread(string& type) override {
+        if (type == "basic") {
+            return new BasicWheatGarlicBread();
+        } else if (type == "cheese") {
+            return new CheeseWheatGarlicBread();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+
+    void createBurgers(span<const BurgerType> orders, ProductBatch<Burger>& out) override {
+        fillBatch<Burger, BurgerType, BasicWheatBurger, StandardWheatBurger, PremiumWheatBurger>(orders, out);
+    }
+
+    void createGarlicBreads(span<const GarlicBreadType> orders, ProductBatch<GarlicBread>& out) override {
+        fillBatch<GarlicBread, GarlicBreadType, BasicWheatGarlicBread, CheeseWheatGarlicBread>(orders, out);
+    }
+};
+
+template <typename Run>
+void bench(const string& label, int rounds, size_t orders, Run run) {
+    long calories = 0;
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        calories += run();
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    double total = double(rounds) * orders;
+    cout << "  " << label << " | " << total / secs / 1e6 << " M orders/s | " << secs * 1e9 / total
+         << " ns per order | checksum " << calories << endl;
+}
+
+int main() {
+    string burgerType = "basic";
+    string garlicBreadType = "cheese";
+
+    MealFactory* mealFactory = new KingBurger();
+
+    Burger* burger = mealFactory->createBurger(burgerType);
+    GarlicBread* garlicBread = mealFactory->createGarlicBread(garlicBreadType);
+
+    burger->prepare();
+    garlicBread->prepare();
+    burger->serve();
+    garlicBread->serve();
+
+    delete burger;
+    delete garlicBread;
+
+    // The same two items through the batch API.
+    vector<BurgerType> burgerOrders = {BurgerType::Premium, BurgerType::Basic};
+    vector<GarlicBreadType> breadOrders = {GarlicBreadType::Cheese};
+    ProductBatch<Burger> burgers;
+    ProductBatch<GarlicBread> breads;
+    mealFactory->createBurgers(burgerOrders, burgers);
+    mealFactory->createGarlicBreads(breadOrders, breads);
+    burgers.prepareAll();
+    breads.prepareAll();
+    for (size_t i = 0; i < burgers.size(); i++) {
+        burgers[i].serve();
+    }
+    breads[0].serve();
+
+    // Appending to a filled batch, first from the same factory, then from another one.
+    ProductBatch<Burger> appended;
+    vector<BurgerType> one = {BurgerType::Basic};
+    SinghBurger singh;
+    mealFactory->createBurgers(one, appended);
+    mealFactory->createBurgers(one, appended);
+    singh.createBurgers(one, appended);
+    appended.prepareAll();
+    bool appendOk = appended.size() == 3 && appended[0].getCalories() == 420 &&
+                    appended[1].getCalories() == 420 && appended[2].getCalories() == 450;
+    cout << "append to a filled batch: " << (appendOk ? "ok" : "FAILED") << endl;
+    if (!appendOk) {
+        return 1;
+    }
+    delete mealFactory;
+
+    // 1M mixed orders, each a burger and a garlic bread.
+    const size_t orders = 1000000;
+    const int rounds = 5;
+    mt19937 rng(5);
+    static string burgerNames[] = {"basic", "standard", "premium"};
+    static string breadNames[] = {"basic", "cheese"};
+    vector<BurgerType> burgerKinds(orders);
+    vector<GarlicBreadType> breadKinds(orders);
+    for (size_t i = 0; i < orders; i++) {
+        burgerKinds[i] = BurgerType(rng() % 3);
+        breadKinds[i] = GarlicBreadType(rng() % 2);
+    }
+
+    SinghBurger factory;
+    cout << "\n" << orders << " mixed orders x " << rounds << " rounds:" << endl;
+
+    vector<Burger*> itemBurgers(orders);
+    vector<GarlicBread*> itemBreads(orders);
+    bench("per item  ", rounds, orders, [&] {
+        for (size_t i = 0; i < orders; i++) {
+            itemBurgers[i] = factory.createBurger(burgerNames[size_t(burgerKinds[i])]);
+            itemBreads[i] = factory.createGarlicBread(breadNames[size_t(breadKinds[i])]);
+        }
+        long calories = 0;
+        for (size_t i = 0; i < orders; i++) {
+            itemBurgers[i]->prepare();
+            itemBreads[i]->prepare();
+            calories += itemBurgers[i]->getCalories() + itemBreads[i]->getCalories();
+        }
+        for (size_t i = 0; i < orders; i++) {
+            delete itemBurgers[i];
+            delete itemBreads[i];
+        }
+        return calories;
+    });
+
+    bench("batch     ", rounds, orders, [&] {
+        burgers.clear();
+        breads.clear();
+        factory.createBurgers(burgerKinds, burgers);
+        factory.createGarlicBreads(breadKinds, breads);
+        burgers.prepareAll();
+        breads.prepareAll();
+        long calories = 0;
+        for (size_t i = 0; i < orders; i++) {
+            calories += burgers[i].getCalories() + breads[i].getCalories();
+        }
+        return calories;
+    });
+
+    return 0;
+}
@@ -0,0 +1,311 @@
+// A self-registering product registry for the Factory Method pattern.
+//
+// In FactoryMethod.cpp, SinghBurger::createBurger and KingBurger::createBurger pick a product by
+// walking an `if (type == "basic") ... else if` chain. Every call compares strings one by one
+// until it finds a match, so the cost grows with the number of burger types, and adding a type
+// means editing the factory.
+//
+// Here every factory has a BurgerRegistry: a flat, open-addressing hash table from type name to
+// a creator function.
+//   - Products register themselves at static-init time with REGISTER_BURGER(Factory, "name",
+//     Product), next to the product class. The factory's code never changes.
+//   - createBurger takes a string_view. Lookup hashes it (FNV-1a), probes linearly, and compares
+//     the stored hash before the name, so a hit usually costs one string comparison and never
+//     builds a temporary string.
+//   - Cost is O(1) no matter how many types are registered.
+//
+//      +---------------------+        registers at startup       +---------------------+
+//      |   BasicBurger ...   |  ----------------------------->   | BurgerRegistry<F>   |
+//      +---------------------+                                   +---------------------+
+//                                                                | add(name, creator)  |
+//      +---------------------+        createBurger(type)         | create(type)        |
+//      |   SinghBurger       |  ----------------------------->   +---------------------+
+//      +---------------------+
+//
+// main() runs the usual demo, then creates products across 200 registered types through the
+// registry and through an equivalent if/else chain.
+//
+// Build: g++ -std=c++17 -O2 BurgerRegistry.cpp
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+using namespace std;
+
+// Product Class and subclasses
+class Burger {
+public:
+    virtual void prepare() = 0;  // Pure virtual function
+    virtual ~Burger() {}  // Virtual destructor
+};
+
+class BasicBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Basic Burger with bun, patty, and ketchup!" << endl;
+    }
+};
+
+class StandardBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Standard Burger with bun, patty, cheese, and lettuce!" << endl;
+    }
+};
+
+class PremiumBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Premium Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce!" << endl;
+    }
+};
+
+class BasicWheatBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Basic Wheat Burger with bun, patty, and ketchup!" << endl;
+    }
+};
+
+class StandardWheatBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Standard Wheat Burger with bun, patty, cheese, and lettuce!" << endl;
+    }
+};
+
+class PremiumWheatBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing Premium Wheat Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce!" << endl;
+    }
+};
+
+// Registry of products for one factory. Filled during static initialization, read-only after
+// that, so concurrent createBurger() calls are safe.
+template <typename Factory>
+class BurgerRegistry {
+public:
+    using Creator = Burger* (*)();
+
+private:
+    struct Slot {
+        string name;
+        uint64_t hash = 0;
+        Creator create = nullptr;   // nullptr = empty slot
+    };
+
+    vector<Slot> slots = vector<Slot>(16);
+    size_t count = 0;
+
+    BurgerRegistry() {}
+
+    static uint64_t hashOf(string_view name) {
+        uint64_t h = 1469598103934665603ULL;
+        for (char c : name) {
+            h = (h ^ uint8_t(c)) * 1099511628211ULL;
+        }
+        return h;
+    }
+
+    const Slot* find(string_view name, uint64_t h) const {
+        size_t mask = slots.size() - 1;
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            const Slot& s = slots[i];
+            if (s.create == nullptr) {
+                return nullptr;
+            }
+            if (s.hash == h && s.name == name) {
+                return &s;
+            }
+        }
+    }
+
+    void insert(Slot&& slot) {
+        size_t mask = slots.size() - 1;
+        size_t i = slot.hash & mask;
+        while (slots[i].create != nullptr) {
+            i = (i + 1) & mask;
+        }
+        slots[i] = move(slot);
+    }
+
+public:
+    static BurgerRegistry& instance() {
+        static BurgerRegistry registry;
+        return registry;
+    }
+
+    // Returns false (and keeps the first one) if `name` is already registered.
+    bool add(string_view name, Creator create) {
+        uint64_t h = hashOf(name);
+        if (find(name, h) != nullptr) {
+            cout << "Burger type registered twice: " << name << endl;
+            return false;
+        }
+        if ((count + 1) * 2 > slots.size()) {   // keep the load factor at or below 1/2
+            vector<Slot> old(slots.size() * 2);
+            old.swap(slots);
+            for (Slot& s : old) {
+                if (s.create != nullptr) {
+                    insert(move(s));
+                }
+            }
+        }
+        insert(Slot{string(name), h, create});
+        count++;
+        return true;
+    }
+
+    Burger* create(string_view name) const {
+        const Slot* s = find(name, hashOf(name));
+        return s ? s->create() : nullptr;
+    }
+
+    size_t size() const { return count; }
+};
+
+#define REGISTER_BURGER(Factory, name, Product)                                         \
+    static const bool registered_##Factory##_##Product =                                 \
+        BurgerRegistry<Factory>::instance().add(name, []() -> Burger* { return new Product(); })
+
+// Factory and its concretions
+class BurgerFactory {
+public:
+    virtual Burger* createBurger(string_view type) = 0;
+    virtual ~BurgerFactory() {}
+};
+
+class SinghBurger : public BurgerFactory {
+public:
+    Burger* createBurger(string_view type) override {
+        Burger* burger = BurgerRegistry<SinghBurger>::instance().create(type);
+        if (burger == nullptr) {
+            cout << "Invalid burger type! " << endl;
+        }
+        return burger;
+    }
+};
+
+class KingBurger : public BurgerFactory {
+public:
+    Burger* createBurger(string_view type) override {
+        Burger* burger = BurgerRegistry<KingBurger>::instance().create(type);
+        if (burger == nullptr) {
+            cout << "Invalid burger type! " << endl;
+        }
+        return burger;
+    }
+};
+
+REGISTER_BURGER(SinghBurger, "basic", BasicBurger);
+REGISTER_BURGER(SinghBurger, "standard", StandardBurger);
+REGISTER_BURGER(SinghBurger, "premium", PremiumBurger);
+
+REGISTER_BURGER(KingBurger, "basic", BasicWheatBurger);
+REGISTER_BURGER(KingBurger, "standard", StandardWheatBurger);
+REGISTER_BURGER(KingBurger, "premium", PremiumWheatBurger);
+
+// ---- Benchmark: a menu of 200 burger types ----
+
+static const int MenuSize = 200;
+
+template <int N>
+class MenuBurger : public Burger {
+public:
+    void prepare() override {
+        cout << "Preparing menu burger #" << N << endl;
+    }
+};
+
+static string menuName(int n) {
+    static const char* bases[] = {"classic", "smoky", "spicy", "veggie", "double", "crispy", "royal", "garden"};
+    return string(bases[n % 8]) + "-" + to_string(n);
+}
+
+class MenuFactory;
+
+// The same menu as an if/else chain: one string comparison per type until a match, like the
+// createBurger() functions in FactoryMethod.cpp.
+class ChainMenuFactory {
+private:
+    vector<pair<string, Burger* (*)()>> menu;
+
+public:
+    Burger* createBurger(string& type) {
+        for (auto& item : menu) {
+            if (type == item.first) {
+                return item.second();
+            }
+        }
+        return nullptr;
+    }
+
+    void add(string name, Burger* (*create)()) {
+        menu.push_back({move(name), create});
+    }
+};
+
+static ChainMenuFactory chainMenu;
+
+template <int N>
+Burger* createMenuBurger() {
+    return new MenuBurger<N>();
+}
+
+template <int... N>
+bool registerMenu(integer_sequence<int, N...>) {
+    ((BurgerRegistry<MenuFactory>::instance().add(menuName(N), &createMenuBurger<N>),
+      chainMenu.add(menuName(N), &createMenuBurger<N>)), ...);
+    return true;
+}
+
+static const bool menuRegistered = registerMenu(make_integer_sequence<int, MenuSize>());
+
+template <typename Create>
+void bench(const string& label, int creations, Create create) {
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < creations; i++) {
+        Burger* burger = create(i);
+        delete burger;
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << label << " | " << secs * 1e9 / creations << " ns per creation | "
+         << creations / secs / 1e6 << " M creations/s" << endl;
+}
+
+int main() {
+    string type = "basic";
+
+    BurgerFactory* myFactory = new SinghBurger();
+
+    Burger* burger = myFactory->createBurger(type);
+
+    burger->prepare();
+
+    delete burger;
+    delete myFactory;
+
+    const int creations = 10000000;
+    mt19937 rng(3);
+    vector<string> orders(4096);
+    for (auto& order : orders) {
+        order = menuName(int(rng() % MenuSize));
+    }
+    const size_t mask = orders.size() - 1;
+
+    cout << "\n" << creations << " creations across " << BurgerRegistry<MenuFactory>::instance().size()
+         << " registered types (uniformly random):" << endl;
+    bench("if/else chain  ", creations, [&](int i) { return chainMenu.createBurger(orders[i & mask]); });
+    bench("hash registry  ", creations, [&](int i) {
+        return BurgerRegistry<MenuFactory>::instance().create(string_view(orders[i & mask]));
+    });
+
+    return 0;
+}
@@ -0,0 +1,324 @@
+/*
+ * Compile-time Abstract Factory Example
+ * -------------------------------------
+ * In AbstractFactory.cpp the family (SinghBurger = regular, KingBurger = wheat) is picked once,
+ * when the MealFactory is created, yet every createBurger(), createGarlicBread() and prepare()
+ * afterwards is a virtual call on a heap object. Code that already knows its family at compile
+ * time pays for that indirection on every meal.
+ *
+ * MealFamily<Tag> is the same family expressed as types:
+ *   - MealFamily<SinghTag>::Burger<BurgerKind::Basic> is BasicBurger,
+ *     MealFamily<KingTag>::Burger<BurgerKind::Basic> is BasicWheatBurger, and so on.
+ *   - Products are plain (non-virtual) classes created by value, so createMeal<...>() builds a
+ *     Meal on the stack and prepare() is inlined.
+ *   - visitMeal(burgerKind, breadKind, f) covers the common middle ground: the family is known
+ *     at compile time but the items come from the order at runtime. One switch picks the
+ *     concrete types, then f runs with them fully resolved.
+ *
+ * For the runtime case (family chosen from config), MealFactoryAdapter<Tag> implements the
+ * classic MealFactory interface on top of MealFamily<Tag>. It type-erases each product into a
+ * BurgerModel<T> / GarlicBreadModel<T> that implements the virtual Burger / GarlicBread
+ * interface, so existing callers keep working unchanged.
+ *
+ * main() runs the demo both ways and then compares meal assembly throughput (create both items,
+ * prepare them, destroy them) through the adapter and through MealFamily<SinghTag>.
+ *
+ * Build: g++ -std=c++17 -O2 MealFamily.cpp
+ */
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+using namespace std;
+
+enum class BurgerKind { Basic, Standard, Premium };
+enum class BreadKind { Basic, Cheese };
+
+// --- Concrete products: no virtual functions ---
+struct ProductInfo {
+    const char* description = "";
+    int calories = 0;
+
+    void serve() const {
+        cout << description << " (" << calories << " kcal)" << endl;
+    }
+};
+
+class BasicBurger : public ProductInfo {
+public:
+    void prepare() { description = "Basic Burger with bun, patty, and ketchup"; calories = 450; }
+};
+
+class StandardBurger : public ProductInfo {
+public:
+    void prepare() { description = "Standard Burger with bun, patty, cheese, and lettuce"; calories = 600; }
+};
+
+class PremiumBurger : public ProductInfo {
+public:
+    void prepare() {
+        description = "Premium Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 850;
+    }
+};
+
+class BasicWheatBurger : public ProductInfo {
+public:
+    void prepare() { description = "Basic Wheat Burger with bun, patty, and ketchup"; calories = 420; }
+};
+
+class StandardWheatBurger : public ProductInfo {
+public:
+    void prepare() { description = "Standard Wheat Burger with bun, patty, cheese, and lettuce"; calories = 570; }
+};
+
+class PremiumWheatBurger : public ProductInfo {
+public:
+    void prepare() {
+        description = "Premium Wheat Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 810;
+    }
+};
+
+class BasicGarlicBread : public ProductInfo {
+public:
+    void prepare() { description = "Basic Garlic Bread with butter and garlic"; calories = 300; }
+};
+
+class CheeseGarlicBread : public ProductInfo {
+public:
+    void prepare() { description = "Cheese Garlic Bread with extra cheese and butter"; calories = 420; }
+};
+
+class BasicWheatGarlicBread : public ProductInfo {
+public:
+    void prepare() { description = "Basic Wheat Garlic Bread with butter and garlic"; calories = 280; }
+};
+
+class CheeseWheatGarlicBread : public ProductInfo {
+public:
+    void prepare() { description = "Cheese Wheat Garlic Bread with extra cheese and butter"; calories = 400; }
+};
+
+template <typename B, typename G>
+struct Meal {
+    B burger;
+    G garlicBread;
+
+    void prepare() {
+        burger.prepare();
+        garlicBread.prepare();
+    }
+
+    int calories() const { return burger.calories + garlicBread.calories; }
+};
+
+// --- Families as types ---
+struct SinghTag {};
+struct KingTag {};
+
+template <typename Tag>
+struct FamilyProducts;
+
+template <>
+struct FamilyProducts<SinghTag> {
+    using Basic = BasicBurger;
+    using Standard = StandardBurger;
+    using Premium = PremiumBurger;
+    using BasicBread = BasicGarlicBread;
+    using CheeseBread = CheeseGarlicBread;
+};
+
+template <>
+struct FamilyProducts<KingTag> {
+    using Basic = BasicWheatBurger;
+    using Standard = StandardWheatBurger;
+    using Premium = PremiumWheatBurger;
+    using BasicBread = BasicWheatGarlicBread;
+    using CheeseBread = CheeseWheatGarlicBread;
+};
+
+template <typename Tag>
+struct MealFamily {
+    using Products = FamilyProducts<Tag>;
+
+    template <BurgerKind K>
+    using Burger = conditional_t<K == BurgerKind::Basic, typename Products::Basic,
+                   conditional_t<K == BurgerKind::Standard, typename Products::Standard,
+                                 typename Products::Premium>>;
+
+    template <BreadKind K>
+    using GarlicBread = conditional_t<K == BreadKind::Basic, typename Products::BasicBread,
+                                      typename Products::CheeseBread>;
+
+    template <BurgerKind B, BreadKind G>
+    static Meal<Burger<B>, GarlicBread<G>> createMeal() {
+        return {};
+    }
+
+    // Resolves runtime kinds to concrete types once, then calls f(meal) with them.
+    template <typename F>
+    static void visitMeal(BurgerKind b, BreadKind g, F&& f) {
+        switch (b) {
+            case BurgerKind::Basic: return visitBread<BurgerKind::Basic>(g, f);
+            case BurgerKind::Standard: return visitBread<BurgerKind::Standard>(g, f);
+            default: return visitBread<BurgerKind::Premium>(g, f);
+        }
+    }
+
+private:
+    template <BurgerKind B, typename F>
+    static void visitBread(BreadKind g, F& f) {
+        if (g == BreadKind::Basic) {
+            auto meal = createMeal<B, BreadKind::Basic>();
+            f(meal);
+        } else {
+            auto meal = createMeal<B, BreadKind::Cheese>();
+            f(meal);
+        }
+    }
+};
+
+// --- Runtime path: the classic AbstractFactory interface, type-erased over MealFamily ---
+class Burger {
+public:
+    virtual void prepare() = 0;
+    virtual const ProductInfo& info() const = 0;
+    virtual ~Burger() {}
+};
+
+class GarlicBread {
+public:
+    virtual void prepare() = 0;
+    virtual const ProductInfo& info() const = 0;
+    virtual ~GarlicBread() {}
+};
+
+template <typename T>
+class BurgerModel : public Burger {
+    T product;
+public:
+    void prepare() override { product.prepare(); }
+    const ProductInfo& info() const override { return product; }
+};
+
+template <typename T>
+class GarlicBreadModel : public GarlicBread {
+    T product;
+public:
+    void prepare() override { product.prepare(); }
+    const ProductInfo& info() const override { return product; }
+};
+
+class MealFactory {
+public:
+    virtual Burger* createBurger(string& type) = 0;
+    virtual GarlicBread* createGarlicBread(string& type) = 0;
+    virtual ~MealFactory() {}
+};
+
+template <typename Tag>
+class MealFactoryAdapter : public MealFactory {
+    using Family = MealFamily<Tag>;
+
+public:
+    Burger* createBurger(string& type) override {
+        if (type == "basic") {
+            return new BurgerModel<typename Family::template Burger<BurgerKind::Basic>>();
+        } else if (type == "standard") {
+            return new BurgerModel<typename Family::template Burger<BurgerKind::Standard>>();
+        } else if (type == "premium") {
+            return new BurgerModel<typename Family::template Burger<BurgerKind::Premium>>();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    GarlicBread* createGarlicBread(string& type) override {
+        if (type == "basic") {
+            return new GarlicBreadModel<typename Family::template GarlicBread<BreadKind::Basic>>();
+        } else if (type == "cheese") {
+            return new GarlicBreadModel<typename Family::template GarlicBread<BreadKind::Cheese>>();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+};
+
+using SinghBurger = MealFactoryAdapter<SinghTag>;
+using KingBurger = MealFactoryAdapter<KingTag>;
+
+template <typename Assemble>
+void bench(const string& label, long meals, Assemble assemble) {
+    long calories = 0;
+    auto start = chrono::steady_clock::now();
+    for (long i = 0; i < meals; i++) {
+        calories += assemble(i);
+        asm volatile("" : "+r"(calories));   // keep every meal
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << label << " | " << meals / secs / 1e6 << " M meals/s | " << secs * 1e9 / meals
+         << " ns per meal | checksum " << calories << endl;
+}
+
+int main() {
+    string burgerType = "basic";
+    string garlicBreadType = "cheese";
+
+    // Runtime family, classic interface.
+    MealFactory* mealFactory = new KingBurger();
+
+    Burger* burger = mealFactory->createBurger(burgerType);
+    GarlicBread* garlicBread = mealFactory->createGarlicBread(garlicBreadType);
+
+    burger->prepare();
+    garlicBread->prepare();
+    burger->info().serve();
+    garlicBread->info().serve();
+
+    delete burger;
+    delete garlicBread;
+    delete mealFactory;
+
+    // Family known at compile time: no heap, no virtual calls.
+    auto meal = MealFamily<KingTag>::createMeal<BurgerKind::Basic, BreadKind::Cheese>();
+    meal.prepare();
+    meal.burger.serve();
+    meal.garlicBread.serve();
+
+    const long meals = 20000000;
+    static string burgerNames[] = {"basic", "standard", "premium"};
+    static string breadNames[] = {"basic", "cheese"};
+    static const BurgerKind burgerKinds[] = {BurgerKind::Basic, BurgerKind::Standard, BurgerKind::Premium};
+    static const BreadKind breadKinds[] = {BreadKind::Basic, BreadKind::Cheese};
+
+    cout << "\n" << meals << " meals (mixed burger and bread kinds):" << endl;
+
+    MealFactory* runtimeFactory = new SinghBurger();
+    bench("MealFactory* (type-erased)   ", meals, [&](long i) {
+        Burger* b = runtimeFactory->createBurger(burgerNames[i % 3]);
+        GarlicBread* g = runtimeFactory->createGarlicBread(breadNames[i % 2]);
+        b->prepare();
+        g->prepare();
+        int calories = b->info().calories + g->info().calories;
+        delete b;
+        delete g;
+        return calories;
+    });
+    delete runtimeFactory;
+
+    bench("MealFamily<SinghTag>         ", meals, [&](long i) {
+        int calories = 0;
+        MealFamily<SinghTag>::visitMeal(burgerKinds[i % 3], breadKinds[i % 2], [&](auto& m) {
+            m.prepare();
+            calories = m.calories();
+        });
+        return calories;
+    });
+
+    return 0;
+}
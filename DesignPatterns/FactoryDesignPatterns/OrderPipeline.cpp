@@ -0,0 +1,640 @@
+/*
+ * Parallel Order Pipeline on the Abstract Factory
+ * -----------------------------------------------
+ * AbstractFactory.cpp creates and prepares one meal at a time in main(). A kitchen taking
+ * orders from many tills needs more than that. Here every order goes through five stages, and
+ * each stage runs on its own group of threads:
+ *
+ *   LoadGenerator ──> [parse] ──> [choose factory] ──> [create] ──> [prepare] ──> [package]
+ *     (tills)      q0         q1                  q2           q3            q4
+ *
+ *   parse           splits "king premium cheese" into family, burger type and bread type
+ *   choose factory  maps the family to the shared SinghBurger / KingBurger MealFactory
+ *   create          factory->createBurger() / createGarlicBread()
+ *   prepare         burger->prepare(), garlicBread->prepare()
+ *   package         writes the receipt, frees the products and retires the order
+ *
+ * Stages hand Order* to each other through bounded lock-free MPMC queues, the same
+ * sequence-numbered ring as in ObserverDesignPattern/WorkStealingChannel.cpp. A full queue
+ * pushes back on the stage before it, which spins (yielding) and counts the stall. So under
+ * overload, work piles up in front of the slowest stage rather than in memory.
+ *
+ * Each worker keeps its own counters and latency histograms (log2 buckets), so recording adds
+ * no shared writes. They are merged when the run ends:
+ *   - stage latency: from entering the stage's input queue to finishing it (wait + service)
+ *   - busy:          service time over wall time x threads; the busiest stage is the bottleneck
+ *   - stalls:        failed pushes into a full downstream queue
+ *   - end to end:    from order creation at the till to packaging
+ *
+ * main() runs the usual demo, then the LoadGenerator pushes orders from several till threads
+ * as fast as the first queue accepts them for a fixed time (saturation) and prints the
+ * per-stage report.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread OrderPipeline.cpp
+ */
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Product 1 --> Burger
+class Burger {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;  // Pure virtual function
+    virtual ~Burger() {}  // Virtual destructor
+
+    const char* getDescription() const { return description; }
+    int getCalories() const { return calories; }
+};
+
+class BasicBurger : public Burger {
+public:
+    void prepare() override { description = "Basic Burger with bun, patty, and ketchup"; calories = 450; }
+};
+
+class StandardBurger : public Burger {
+public:
+    void prepare() override { description = "Standard Burger with bun, patty, cheese, and lettuce"; calories = 600; }
+};
+
+class PremiumBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 850;
+    }
+};
+
+class BasicWheatBurger : public Burger {
+public:
+    void prepare() override { description = "Basic Wheat Burger with bun, patty, and ketchup"; calories = 420; }
+};
+
+class StandardWheatBurger : public Burger {
+public:
+    void prepare() override { description = "Standard Wheat Burger with bun, patty, cheese, and lettuce"; calories = 570; }
+};
+
+class PremiumWheatBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Wheat Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 810;
+    }
+};
+
+// Product 2 --> GarlicBread
+class GarlicBread {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;
+    virtual ~GarlicBread() {}
+
+    const char* getDescription() const { return description; }
+    int getCalories() const { return calories; }
+};
+
+class BasicGarlicBread : public GarlicBread {
+public:
+    void prepare() override { description = "Basic Garlic Bread with butter and garlic"; calories = 300; }
+};
+
+class CheeseGarlicBread : public GarlicBread {
+public:
+    void prepare() override { description = "Cheese Garlic Bread with extra cheese and butter"; calories = 420; }
+};
+
+class BasicWheatGarlicBread : public GarlicBread {
+public:
+    void prepare() override { description = "Basic Wheat Garlic Bread with butter and garlic"; calories = 280; }
+};
+
+class CheeseWheatGarlicBread : public GarlicBread {
+public:
+    void prepare() override { description = "Cheese Wheat Garlic Bread with extra cheese and butter"; calories = 400; }
+};
+
+// Factory and its concretions. They hold no state, so one instance of each serves every
+// create-stage thread.
+class MealFactory {
+public:
+    virtual Burger* createBurger(string& type) = 0;
+    virtual GarlicBread* createGarlicBread(string& type) = 0;
+    virtual ~MealFactory() {}
+};
+
+class SinghBurger : public MealFactory {
+public:
+    Burger* createBurger(string& type) override {
+        if (type == "basic") {
+            return new BasicBurger();
+        } else if (type == "standard") {
+            return new StandardBurger();
+        } else if (type == "premium") {
+            return new PremiumBurger();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    GarlicBread* createGarlicBread(string& type) override {
+        if (type == "basic") {
+            return new BasicGarlicBread();
+        } else if (type == "cheese") {
+            return new CheeseGarlicBread();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+};
+
+class KingBurger : public MealFactory {
+public:
+    Burger* createBurger(string& type) override {
+        if (type == "basic") {
+            return new BasicWheatBurger();
+        } else if (type == "standard") {
+            return new StandardWheatBurger();
+        } else if (type == "premium") {
+            return new PremiumWheatBurger();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    GarlicBread* createGarlicBread(string& type) override {
+        if (type == "basic") {
+            return new BasicWheatGarlicBread();
+        } else if (type == "cheese") {
+            return new CheeseWheatGarlicBread();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+};
+
+// Bounded lock-free MPMC queue (capacity rounded up to a power of two).
+template <typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    vector<Cell> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos{0};
+    alignas(64) atomic<size_t> dequeuePos{0};
+
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+public:
+    explicit MpmcQueue(size_t capacity) : cells(roundUp(capacity)), mask(cells.size() - 1) {
+        for (size_t i = 0; i < cells.size(); i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            intptr_t diff = intptr_t(cell.sequence.load(memory_order_acquire)) - intptr_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            intptr_t diff = intptr_t(cell.sequence.load(memory_order_acquire)) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // empty
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+};
+
+using Clock = chrono::steady_clock;
+
+static uint64_t nanosBetween(Clock::time_point from, Clock::time_point to) {
+    return uint64_t(chrono::duration_cast<chrono::nanoseconds>(to - from).count());
+}
+
+// An order as it moves down the pipeline. Each stage fills in its part.
+struct Order {
+    uint64_t id = 0;
+    string text;                         // "king premium cheese", from the till
+    string family, burgerType, breadType;   // parse
+    MealFactory* factory = nullptr;      // choose factory
+    Burger* burger = nullptr;            // create
+    GarlicBread* garlicBread = nullptr;  // create
+    string receipt;                      // package
+    int calories = 0;
+    Clock::time_point created;           // at the till
+    Clock::time_point queuedAt;          // when it entered the current stage's queue
+};
+
+// Latency histogram with power-of-two buckets: bucket b holds values in [2^(b-1), 2^b) ns.
+class LatencyHistogram {
+private:
+    array<uint64_t, 48> buckets{};
+    uint64_t count = 0;
+    uint64_t sumNs = 0;
+    uint64_t maxNs = 0;
+
+public:
+    void record(uint64_t ns) {
+        size_t b = ns == 0 ? 0 : size_t(64 - __builtin_clzll(ns));
+        buckets[min(b, buckets.size() - 1)]++;
+        count++;
+        sumNs += ns;
+        maxNs = max(maxNs, ns);
+    }
+
+    void merge(const LatencyHistogram& other) {
+        for (size_t b = 0; b < buckets.size(); b++) {
+            buckets[b] += other.buckets[b];
+        }
+        count += other.count;
+        sumNs += other.sumNs;
+        maxNs = max(maxNs, other.maxNs);
+    }
+
+    // Upper bound of the bucket that holds the p-th percentile.
+    uint64_t percentile(double p) const {
+        uint64_t rank = uint64_t(p / 100.0 * count);
+        uint64_t seen = 0;
+        for (size_t b = 0; b < buckets.size(); b++) {
+            seen += buckets[b];
+            if (seen > rank) {
+                return min(b == 0 ? 0 : uint64_t(1) << b, maxNs);
+            }
+        }
+        return maxNs;
+    }
+
+    uint64_t total() const { return count; }
+    uint64_t mean() const { return count ? sumNs / count : 0; }
+    uint64_t maximum() const { return maxNs; }
+};
+
+// Per-worker counters: written by one thread only, read after join().
+struct alignas(64) WorkerStats {
+    uint64_t processed = 0;
+    uint64_t busyNs = 0;
+    uint64_t stalls = 0;
+    LatencyHistogram latency;     // wait + service in this stage
+    LatencyHistogram endToEnd;    // last stage only
+};
+
+class Stage {
+public:
+    using Work = function<void(Order&)>;
+
+private:
+    string name;
+    int threads;
+    Work work;
+    MpmcQueue<Order*> input;
+    Stage* next = nullptr;
+    atomic<bool> upstreamDone{false};
+    atomic<int> running{0};
+    vector<unique_ptr<WorkerStats>> stats;
+    vector<thread> workers;
+
+    void run(WorkerStats& s) {
+        while (true) {
+            bool done = upstreamDone.load(memory_order_acquire);   // read before trying to pop
+            Order* order;
+            if (!input.tryPop(order)) {
+                if (done) {
+                    break;
+                }
+                this_thread::yield();
+                continue;
+            }
+
+            Clock::time_point start = Clock::now();
+            work(*order);
+            Clock::time_point end = Clock::now();
+            s.processed++;
+            s.busyNs += nanosBetween(start, end);
+            s.latency.record(nanosBetween(order->queuedAt, end));
+
+            if (next != nullptr) {
+                order->queuedAt = end;
+                while (!next->input.tryPush(order)) {   // downstream is full: back off
+                    s.stalls++;
+                    this_thread::yield();
+                }
+            } else {
+                s.endToEnd.record(nanosBetween(order->created, end));
+                delete order;
+            }
+        }
+
+        // The last worker out tells the next stage that nothing more is coming.
+        if (running.fetch_sub(1, memory_order_acq_rel) == 1 && next != nullptr) {
+            next->upstreamDone.store(true, memory_order_release);
+        }
+    }
+
+public:
+    Stage(string name, int threads, size_t capacity, Work work)
+        : name(move(name)), threads(threads), work(move(work)), input(capacity) {}
+
+    ~Stage() { join(); }
+
+    void connect(Stage* downstream) { next = downstream; }
+
+    void start() {
+        running.store(threads, memory_order_relaxed);
+        for (int t = 0; t < threads; t++) {
+            stats.push_back(make_unique<WorkerStats>());
+            WorkerStats* s = stats.back().get();
+            workers.emplace_back([this, s] { run(*s); });
+        }
+    }
+
+    bool tryPush(Order* order) { return input.tryPush(order); }
+
+    // No more input: workers exit once the queue is drained.
+    void close() { upstreamDone.store(true, memory_order_release); }
+
+    void join() {
+        for (auto& w : workers) {
+            w.join();
+        }
+        workers.clear();
+    }
+
+    const string& getName() const { return name; }
+    int getThreads() const { return threads; }
+
+    WorkerStats totals() const {
+        WorkerStats sum;
+        for (auto& s : stats) {
+            sum.processed += s->processed;
+            sum.busyNs += s->busyNs;
+            sum.stalls += s->stalls;
+            sum.latency.merge(s->latency);
+            sum.endToEnd.merge(s->endToEnd);
+        }
+        return sum;
+    }
+};
+
+class OrderPipeline {
+private:
+    vector<unique_ptr<Stage>> stages;
+    SinghBurger singh;
+    KingBurger king;
+    atomic<uint64_t> rejected{0};
+
+    static void split(string_view text, string* const* fields, size_t count) {
+        for (size_t i = 0; i < count; i++) {
+            size_t space = text.find(' ');
+            fields[i]->assign(text.substr(0, space));
+            text = space == string_view::npos ? string_view() : text.substr(space + 1);
+        }
+    }
+
+public:
+    struct Config {
+        int parseThreads = 1;
+        int chooseThreads = 1;
+        int createThreads = 2;
+        int prepareThreads = 1;
+        int packageThreads = 1;
+        size_t queueCapacity = 1024;
+    };
+
+    explicit OrderPipeline(const Config& config) {
+        size_t cap = config.queueCapacity;
+
+        stages.push_back(make_unique<Stage>("parse", config.parseThreads, cap, [](Order& o) {
+            string* fields[] = {&o.family, &o.burgerType, &o.breadType};
+            split(o.text, fields, 3);
+        }));
+
+        stages.push_back(make_unique<Stage>("choose factory", config.chooseThreads, cap, [this](Order& o) {
+            if (o.family == "singh") {
+                o.factory = &singh;
+            } else if (o.family == "king") {
+                o.factory = &king;
+            }
+        }));
+
+        stages.push_back(make_unique<Stage>("create", config.createThreads, cap, [](Order& o) {
+            if (o.factory != nullptr) {
+                o.burger = o.factory->createBurger(o.burgerType);
+                o.garlicBread = o.factory->createGarlicBread(o.breadType);
+            }
+        }));
+
+        stages.push_back(make_unique<Stage>("prepare", config.prepareThreads, cap, [](Order& o) {
+            if (o.burger != nullptr) {
+                o.burger->prepare();
+            }
+            if (o.garlicBread != nullptr) {
+                o.garlicBread->prepare();
+            }
+        }));
+
+        stages.push_back(make_unique<Stage>("package", config.packageThreads, cap, [this](Order& o) {
+            if (o.burger == nullptr || o.garlicBread == nullptr) {
+                rejected.fetch_add(1, memory_order_relaxed);
+                o.receipt = "#" + to_string(o.id) + " rejected: " + o.text;
+            } else {
+                o.calories = o.burger->getCalories() + o.garlicBread->getCalories();
+                o.receipt = "#" + to_string(o.id) + " " + o.burger->getDescription() + " + " +
+                            o.garlicBread->getDescription() + " (" + to_string(o.calories) + " kcal)";
+            }
+            if (o.id == 0) {
+                cout << "  first receipt: " << o.receipt << endl;
+            }
+            delete o.burger;
+            delete o.garlicBread;
+            o.burger = nullptr;
+            o.garlicBread = nullptr;
+        }));
+
+        for (size_t i = 0; i + 1 < stages.size(); i++) {
+            stages[i]->connect(stages[i + 1].get());
+        }
+    }
+
+    void start() {
+        for (auto& stage : stages) {
+            stage->start();
+        }
+    }
+
+    // Non-blocking: false when the first queue is full.
+    bool trySubmit(Order* order) {
+        order->queuedAt = Clock::now();
+        return stages.front()->tryPush(order);
+    }
+
+    // Stop accepting orders and wait until every submitted order is packaged.
+    void drain() {
+        stages.front()->close();
+        for (auto& stage : stages) {
+            stage->join();
+        }
+    }
+
+    void report(double wallSecs) const {
+        cout << "  " << left << setw(15) << "stage" << right << setw(4) << "thr" << setw(11) << "orders"
+             << setw(10) << "Mord/s" << setw(7) << "busy" << setw(11) << "svc ns" << setw(11) << "p50 ns"
+             << setw(11) << "p99 ns" << setw(12) << "max ns" << setw(10) << "stalls" << endl;
+
+        LatencyHistogram endToEnd;
+        for (auto& stage : stages) {
+            WorkerStats s = stage->totals();
+            double busy = s.busyNs / (wallSecs * 1e9 * stage->getThreads());
+            cout << "  " << left << setw(15) << stage->getName() << right << setw(4) << stage->getThreads()
+                 << setw(11) << s.processed << setw(10) << fixed << setprecision(2)
+                 << s.processed / wallSecs / 1e6 << setw(6) << setprecision(0) << busy * 100 << "%"
+                 << setw(11) << (s.processed ? s.busyNs / s.processed : 0) << setw(11)
+                 << s.latency.percentile(50) << setw(11) << s.latency.percentile(99) << setw(12)
+                 << s.latency.maximum() << setw(10) << s.stalls << endl;
+            endToEnd.merge(s.endToEnd);
+        }
+        cout << defaultfloat << setprecision(6);
+        cout << "  end to end: " << endToEnd.total() << " orders | mean " << endToEnd.mean() / 1000
+             << " us | p50 " << endToEnd.percentile(50) / 1000 << " us | p99 "
+             << endToEnd.percentile(99) / 1000 << " us | rejected " << rejected.load() << endl;
+    }
+};
+
+// Tills submitting orders as fast as the pipeline takes them, for a fixed time.
+class LoadGenerator {
+private:
+    int tills;
+    chrono::milliseconds duration;
+    atomic<uint64_t> nextId{0};
+    atomic<uint64_t> fullRetries{0};
+
+public:
+    LoadGenerator(int tills, chrono::milliseconds duration) : tills(tills), duration(duration) {}
+
+    // Returns the wall time from the first order to the last one packaged.
+    double run(OrderPipeline& pipeline) {
+        static const char* families[] = {"singh", "king"};
+        static const char* burgers[] = {"basic", "standard", "premium"};
+        static const char* breads[] = {"basic", "cheese"};
+
+        Clock::time_point start = Clock::now();
+        Clock::time_point stop = start + duration;
+        vector<thread> threads;
+        for (int t = 0; t < tills; t++) {
+            threads.emplace_back([&, t] {
+                mt19937 rng(t + 1);
+                uint64_t retries = 0;
+                while (Clock::now() < stop) {
+                    Order* order = new Order();
+                    order->id = nextId.fetch_add(1, memory_order_relaxed);
+                    order->text = string(families[rng() % 2]) + " " + burgers[rng() % 3] + " " + breads[rng() % 2];
+                    order->created = Clock::now();
+                    while (!pipeline.trySubmit(order)) {   // saturated: wait for room
+                        retries++;
+                        this_thread::yield();
+                    }
+                }
+                fullRetries.fetch_add(retries, memory_order_relaxed);
+            });
+        }
+        for (auto& t : threads) {
+            t.join();
+        }
+        pipeline.drain();
+        return chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    uint64_t submitted() const { return nextId.load(); }
+    uint64_t retries() const { return fullRetries.load(); }
+};
+
+int main() {
+    string burgerType = "basic";
+    string garlicBreadType = "cheese";
+
+    MealFactory* mealFactory = new KingBurger();
+
+    Burger* burger = mealFactory->createBurger(burgerType);
+    GarlicBread* garlicBread = mealFactory->createGarlicBread(garlicBreadType);
+
+    burger->prepare();
+    garlicBread->prepare();
+    cout << burger->getDescription() << " + " << garlicBread->getDescription() << endl;
+
+    delete burger;
+    delete garlicBread;
+    delete mealFactory;
+
+    OrderPipeline::Config config;
+    OrderPipeline pipeline(config);
+    LoadGenerator load(2, chrono::milliseconds(1500));
+
+    cout << "\nPipeline under saturation (" << thread::hardware_concurrency() << " hardware threads, 2 tills, "
+         << "queues of " << config.queueCapacity << "):" << endl;
+    pipeline.start();
+    double secs = load.run(pipeline);
+    cout << "  submitted " << load.submitted() << " orders in " << secs << " s ("
+         << load.submitted() / secs / 1e6 << " M orders/s), first queue full " << load.retries() << " times"
+         << endl;
+    pipeline.report(secs);
+
+    return 0;
+}
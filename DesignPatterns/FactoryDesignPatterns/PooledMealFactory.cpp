@@ -0,0 +1,496 @@
+/*
+ * Pooled / Arena Abstract Factory Example
+ * ---------------------------------------
+ * In AbstractFactory.cpp every createBurger() / createGarlicBread() returns a fresh `new`
+ * object, and main() never deletes it. A kitchen serving orders at a high rate would spend
+ * much of its time in malloc/free (or leak).
+ *
+ * Here a MealFactory can be configured with one of three allocation modes, and always returns
+ * an RAII handle (ProductHandle<T>, a unique_ptr) that gives the object back when it goes away:
+ *   - Allocation::Heap  : plain new/delete, as before.
+ *   - Allocation::Pool  : one free-list pool per concrete product type. Releasing a handle runs
+ *                         the destructor and puts the block back on its pool's free list, so the
+ *                         next order of that type reuses it.
+ *   - Allocation::Arena : products are bump-allocated from a per-request MealArena. Releasing a
+ *                         handle only runs the destructor; the memory comes back all at once when
+ *                         the request is done and the arena is reset.
+ *
+ * Pools and arenas are not thread-safe. Each kitchen thread owns its own factory (and arena),
+ * and handles are released on the thread that created them.
+ *
+ * A pooled handle may outlive its factory: the factory detaches its pools when it is destroyed,
+ * and a detached pool frees itself once its last block comes back. An arena is owned by the
+ * caller and must not be reset or destroyed while its handles are alive (reset() reports it).
+ *
+ * main() runs the usual demo, then 8 threads doing create/prepare/destroy cycles (one burger
+ * and one garlic bread each) in all three modes.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread PooledMealFactory.cpp
+ */
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+// Where a product's memory goes back to when its handle is released.
+class Recycler {
+public:
+    virtual void recycle(void* block) = 0;
+    virtual ~Recycler() {}
+};
+
+// Deleter for product handles. No owner means the product came from the heap.
+template <typename T>
+struct ProductRelease {
+    Recycler* owner = nullptr;
+
+    void operator()(T* product) const {
+        if (owner == nullptr) {
+            delete product;
+            return;
+        }
+        product->~T();   // virtual: destroys the concrete product
+        owner->recycle(product);
+    }
+};
+
+template <typename T>
+using ProductHandle = unique_ptr<T, ProductRelease<T>>;
+
+// Free-list pool of fixed-size blocks for one concrete product type. Created by a factory
+// and released with detach(), never deleted directly: handles still out keep it alive.
+class ObjectPool : public Recycler {
+private:
+    union Block {
+        Block* next;
+        max_align_t align;
+    };
+
+    static const size_t SlabBlocks = 256;
+
+    size_t blockSize;
+    vector<void*> slabs;
+    Block* freeList = nullptr;
+    size_t live = 0;          // blocks handed out and not yet recycled
+    bool detached = false;    // the factory is gone; the last recycle() frees the pool
+
+    ~ObjectPool() {
+        for (void* slab : slabs) {
+            ::operator delete(slab);
+        }
+    }
+
+public:
+    ObjectPool(size_t objectSize)
+        : blockSize((objectSize + sizeof(Block) - 1) / sizeof(Block) * sizeof(Block)) {}
+
+    ObjectPool(const ObjectPool&) = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+
+    // Called by the owning factory instead of delete.
+    void detach() {
+        detached = true;
+        if (live == 0) {
+            delete this;
+        }
+    }
+
+    void* allocate() {
+        if (freeList == nullptr) {
+            char* slab = static_cast<char*>(::operator new(blockSize * SlabBlocks));
+            slabs.push_back(slab);
+            for (size_t i = 0; i < SlabBlocks; i++) {
+                Block* b = reinterpret_cast<Block*>(slab + i * blockSize);
+                b->next = freeList;
+                freeList = b;
+            }
+        }
+        Block* b = freeList;
+        freeList = b->next;
+        live++;
+        return b;
+    }
+
+    void recycle(void* block) override {
+        Block* b = static_cast<Block*>(block);
+        b->next = freeList;
+        freeList = b;
+        if (--live == 0 && detached) {
+            delete this;
+        }
+    }
+};
+
+// Bump allocator for the products of one request. reset() reclaims everything at once.
+class MealArena : public Recycler {
+private:
+    static const size_t Capacity = 4096;
+
+    alignas(max_align_t) char buffer[Capacity];
+    size_t used = 0;
+    int live = 0;
+    vector<void*> overflow;   // requests bigger than the buffer spill to the heap
+
+public:
+    ~MealArena() {
+        reset();
+    }
+
+    void* allocate(size_t size) {
+        size_t aligned = (size + alignof(max_align_t) - 1) / alignof(max_align_t) * alignof(max_align_t);
+        live++;
+        if (used + aligned > Capacity) {
+            overflow.push_back(::operator new(size));
+            return overflow.back();
+        }
+        void* p = buffer + used;
+        used += aligned;
+        return p;
+    }
+
+    // Destructors have already run; memory is reclaimed by reset().
+    void recycle(void*) override {
+        live--;
+    }
+
+    // Every handle from this request must have been released.
+    void reset() {
+        if (live != 0) {
+            cout << "MealArena reset with " << live << " products still alive!" << endl;
+        }
+        for (void* p : overflow) {
+            ::operator delete(p);
+        }
+        overflow.clear();
+        used = 0;
+        live = 0;
+    }
+};
+
+// Product 1 --> Burger
+class Burger {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;  // Pure virtual function
+    virtual ~Burger() {}  // Virtual destructor
+
+    void serve() const {
+        cout << description << " (" << calories << " kcal)" << endl;
+    }
+
+    int getCalories() const { return calories; }
+};
+
+class BasicBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Basic Burger with bun, patty, and ketchup";
+        calories = 450;
+    }
+};
+
+class StandardBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Standard Burger with bun, patty, cheese, and lettuce";
+        calories = 600;
+    }
+};
+
+class PremiumBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 850;
+    }
+};
+
+class BasicWheatBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Basic Wheat Burger with bun, patty, and ketchup";
+        calories = 420;
+    }
+};
+
+class StandardWheatBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Standard Wheat Burger with bun, patty, cheese, and lettuce";
+        calories = 570;
+    }
+};
+
+class PremiumWheatBurger : public Burger {
+public:
+    void prepare() override {
+        description = "Premium Wheat Burger with gourmet bun, premium patty, cheese, lettuce, and secret sauce";
+        calories = 810;
+    }
+};
+
+// Product 2 --> GarlicBread
+class GarlicBread {
+protected:
+    const char* description = "";
+    int calories = 0;
+
+public:
+    virtual void prepare() = 0;
+    virtual ~GarlicBread() {}
+
+    void serve() const {
+        cout << description << " (" << calories << " kcal)" << endl;
+    }
+
+    int getCalories() const { return calories; }
+};
+
+class BasicGarlicBread : public GarlicBread {
+public:
+    void prepare() override {
+        description = "Basic Garlic Bread with butter and garlic";
+        calories = 300;
+    }
+};
+
+class CheeseGarlicBread : public GarlicBread {
+public:
+    void prepare() override {
+        description = "Cheese Garlic Bread with extra cheese and butter";
+        calories = 420;
+    }
+};
+
+class BasicWheatGarlicBread : public GarlicBread {
+public:
+    void prepare() override {
+        description = "Basic Wheat Garlic Bread with butter and garlic";
+        calories = 280;
+    }
+};
+
+class CheeseWheatGarlicBread : public GarlicBread {
+public:
+    void prepare() override {
+        description = "Cheese Wheat Garlic Bread with extra cheese and butter";
+        calories = 400;
+    }
+};
+
+enum class Allocation { Heap, Pool, Arena };
+
+// Factory and its concretions
+class MealFactory {
+private:
+    Allocation mode;
+    MealArena* arena = nullptr;
+    vector<ObjectPool*> pools;   // indexed by productSlot<T>(); detached, not deleted, on destruction
+
+    static size_t nextSlot() {
+        static atomic<size_t> next{0};
+        return next.fetch_add(1);
+    }
+
+    // A small dense index per concrete product type, assigned on first use.
+    template <typename T>
+    static size_t productSlot() {
+        static const size_t slot = nextSlot();
+        return slot;
+    }
+
+protected:
+    // Creates a T in the configured mode and hands it out as a handle to its Base.
+    template <typename Base, typename T>
+    ProductHandle<Base> make() {
+        switch (mode) {
+            case Allocation::Pool: {
+                size_t slot = productSlot<T>();
+                if (slot >= pools.size()) {
+                    pools.resize(slot + 1);
+                }
+                if (!pools[slot]) {
+                    pools[slot] = new ObjectPool(sizeof(T));
+                }
+                return ProductHandle<Base>(new (pools[slot]->allocate()) T(), ProductRelease<Base>{pools[slot]});
+            }
+            case Allocation::Arena:
+                if (arena != nullptr) {
+                    return ProductHandle<Base>(new (arena->allocate(sizeof(T))) T(), ProductRelease<Base>{arena});
+                }
+                return ProductHandle<Base>(new T());   // no arena set: fall back to the heap
+            default:
+                return ProductHandle<Base>(new T());
+        }
+    }
+
+public:
+    MealFactory(Allocation mode = Allocation::Heap) : mode(mode) {}
+    MealFactory(const MealFactory&) = delete;
+    MealFactory& operator=(const MealFactory&) = delete;
+
+    virtual ~MealFactory() {
+        for (ObjectPool* pool : pools) {
+            if (pool != nullptr) {
+                pool->detach();
+            }
+        }
+    }
+
+    // The arena used by Allocation::Arena for the current request.
+    void useArena(MealArena* a) { arena = a; }
+
+    virtual ProductHandle<Burger> createBurger(string_view type) = 0;
+    virtual ProductHandle<GarlicBread> createGarlicBread(string_view type) = 0;
+};
+
+class SinghBurger : public MealFactory {
+public:
+    using MealFactory::MealFactory;
+
+    ProductHandle<Burger> createBurger(string_view type) override {
+        if (type == "basic") {
+            return make<Burger, BasicBurger>();
+        } else if (type == "standard") {
+            return make<Burger, StandardBurger>();
+        } else if (type == "premium") {
+            return make<Burger, PremiumBurger>();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    ProductHandle<GarlicBread> createGarlicBread(string_view type) override {
+        if (type == "basic") {
+            return make<GarlicBread, BasicGarlicBread>();
+        } else if (type == "cheese") {
+            return make<GarlicBread, CheeseGarlicBread>();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+};
+
+class KingBurger : public MealFactory {
+public:
+    using MealFactory::MealFactory;
+
+    ProductHandle<Burger> createBurger(string_view type) override {
+        if (type == "basic") {
+            return make<Burger, BasicWheatBurger>();
+        } else if (type == "standard") {
+            return make<Burger, StandardWheatBurger>();
+        } else if (type == "premium") {
+            return make<Burger, PremiumWheatBurger>();
+        } else {
+            cout << "Invalid burger type! " << endl;
+            return nullptr;
+        }
+    }
+
+    ProductHandle<GarlicBread> createGarlicBread(string_view type) override {
+        if (type == "basic") {
+            return make<GarlicBread, BasicWheatGarlicBread>();
+        } else if (type == "cheese") {
+            return make<GarlicBread, CheeseWheatGarlicBread>();
+        } else {
+            cout << "Invalid Garlic bread type! " << endl;
+            return nullptr;
+        }
+    }
+};
+
+// `threads` kitchens, each with its own factory, doing `cycles` create/prepare/destroy cycles.
+static void bench(const string& label, Allocation mode, int threads, long cycles) {
+    static const string_view burgers[] = {"basic", "standard", "premium"};
+    static const string_view breads[] = {"basic", "cheese"};
+    vector<thread> kitchens;
+    vector<long> calories(threads);
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < threads; t++) {
+        kitchens.emplace_back([&, t] {
+            unique_ptr<MealFactory> factory;
+            if (t % 2 == 0) {
+                factory = make_unique<SinghBurger>(mode);
+            } else {
+                factory = make_unique<KingBurger>(mode);
+            }
+            MealArena arena;
+            long total = 0;
+            for (long i = 0; i < cycles / threads; i++) {
+                factory->useArena(&arena);
+                {
+                    ProductHandle<Burger> burger = factory->createBurger(burgers[i % 3]);
+                    ProductHandle<GarlicBread> bread = factory->createGarlicBread(breads[i % 2]);
+                    burger->prepare();
+                    bread->prepare();
+                    total += burger->getCalories() + bread->getCalories();
+                }
+                arena.reset();   // end of request
+            }
+            calories[t] = total;
+        });
+    }
+    for (auto& k : kitchens) {
+        k.join();
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long total = 0;
+    for (long c : calories) {
+        total += c;
+    }
+    cout << "  " << label << " | " << cycles / secs / 1e6 << " M cycles/s | " << secs * 1e9 / cycles
+         << " ns per cycle | checksum " << total << endl;
+}
+
+int main() {
+    string burgerType = "basic";
+    string garlicBreadType = "cheese";
+
+    MealArena arena;
+    MealFactory* mealFactory = new KingBurger(Allocation::Arena);
+    mealFactory->useArena(&arena);
+
+    {
+        ProductHandle<Burger> burger = mealFactory->createBurger(burgerType);
+        ProductHandle<GarlicBread> garlicBread = mealFactory->createGarlicBread(garlicBreadType);
+
+        burger->prepare();
+        garlicBread->prepare();
+        burger->serve();
+        garlicBread->serve();
+    }   // handles released here
+    arena.reset();
+    delete mealFactory;
+
+    // A pooled handle outliving its factory: released afterwards into the detached pool.
+    {
+        MealFactory* shortLived = new SinghBurger(Allocation::Pool);
+        ProductHandle<Burger> burger = shortLived->createBurger("premium");
+        delete shortLived;
+        burger->prepare();
+        burger->serve();
+    }
+
+    const int threads = 8;
+    const long cycles = 20000000;
+    cout << "\n" << threads << " threads, " << cycles << " create/prepare/destroy cycles (burger + garlic bread):" << endl;
+    bench("heap  ", Allocation::Heap, threads, cycles);
+    bench("pool  ", Allocation::Pool, threads, cycles);
+    bench("arena ", Allocation::Arena, threads, cycles);
+
+    return 0;
+}
@@ -0,0 +1,466 @@
+/*
+Asynchronous Observer (fan-out dispatcher):
+
+In main.cpp, Channel::notify() calls update() on every subscriber from the publishing
+thread, so one slow subscriber stalls uploadVideo() for everyone.
+
+Here notify() only drops a notification into a small bounded queue (a "mailbox") owned by
+each subscriber and returns. A pool of worker threads drains the mailboxes and calls
+update() off the publisher thread.
+
+- Every mailbox is a lock-free single-producer / single-consumer ring buffer: the publisher
+  is the only producer and each mailbox is pinned to exactly one worker (the consumer).
+- When a mailbox is full, the BackpressurePolicy decides what happens:
+    DropOldest -> throw away the oldest pending notification and enqueue the new one
+    Block      -> the publisher waits until the worker frees a slot
+    Coalesce   -> skip the enqueue, the pending notification already covers this upload
+- Publishing costs one O(1) enqueue per subscriber, no matter how long update() takes.
+
+─────────────   enqueue    ┌─────────┐   drain    ┌──────────┐   update()   ┌──────────────┐
+│   Channel   │ ---------> │ mailbox │ ---------> │  worker  │ -----------> │ Subscriber N │
+─────────────              └─────────┘            └──────────┘              └──────────────┘
+
+main() runs the usual demo and then measures p50/p99 publish latency with 10k subscribers,
+comparing sync delivery (update() on the publisher thread) with every async policy.
+
+Build: g++ -std=c++17 -O2 -pthread AsyncChannel.cpp -o AsyncChannel
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update() = 0;
+    virtual ~ISubscriber() {}
+};
+
+enum class BackpressurePolicy { DropOldest, Block, Coalesce };
+
+// Bounded lock-free SPSC ring buffer of upload sequence numbers.
+// Capacity must be a power of two. The producer may also discard the oldest element
+// (DropOldest), so the consumer claims an element with a CAS on head instead of a plain store.
+class SpscQueue {
+private:
+    vector<atomic<uint64_t>> slots;
+    size_t mask;
+    alignas(64) atomic<size_t> head{0};   // next slot to read (consumer, or producer when dropping)
+    alignas(64) atomic<size_t> tail{0};   // next slot to write (producer only)
+
+public:
+    explicit SpscQueue(size_t capacity) : slots(capacity), mask(capacity - 1) {}
+
+    size_t capacity() const { return mask + 1; }
+
+    bool empty() const {
+        return head.load(memory_order_acquire) == tail.load(memory_order_acquire);
+    }
+
+    bool full() const {
+        return tail.load(memory_order_relaxed) - head.load(memory_order_acquire) == capacity();
+    }
+
+    // Producer side. Returns false when the queue is full.
+    bool tryPush(uint64_t value) {
+        size_t t = tail.load(memory_order_relaxed);
+        if (t - head.load(memory_order_acquire) == capacity()) {
+            return false;
+        }
+        slots[t & mask].store(value, memory_order_relaxed);
+        tail.store(t + 1, memory_order_release);
+        return true;
+    }
+
+    // Producer side. Makes room by discarding the oldest element. Returns true if one was dropped.
+    bool pushDropOldest(uint64_t value) {
+        bool dropped = false;
+        while (!tryPush(value)) {
+            size_t h = head.load(memory_order_acquire);
+            if (head.compare_exchange_strong(h, h + 1, memory_order_acq_rel)) {
+                dropped = true;
+            }
+        }
+        return dropped;
+    }
+
+    // Consumer side.
+    bool tryPop(uint64_t& value) {
+        size_t h = head.load(memory_order_acquire);
+        while (h != tail.load(memory_order_acquire)) {
+            value = slots[h & mask].load(memory_order_relaxed);
+            if (head.compare_exchange_weak(h, h + 1, memory_order_acq_rel, memory_order_acquire)) {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+// One mailbox per (channel, subscriber) pair.
+struct Mailbox {
+    ISubscriber* subscriber;
+    SpscQueue queue;
+    atomic<uint64_t> dropped{0};
+
+    Mailbox(ISubscriber* sub, size_t capacity) : subscriber(sub), queue(capacity) {}
+};
+
+// Worker pool that drains mailboxes. Each mailbox is owned by one worker for its whole life,
+// which keeps every queue single-consumer.
+class AsyncDispatcher {
+private:
+    struct Worker {
+        mutex mtx;                              // guards mailboxes; held for one drain pass
+        vector<shared_ptr<Mailbox>> mailboxes;
+        thread th;
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    atomic<size_t> nextWorker{0};
+    atomic<bool> running{true};
+
+    mutex wakeMtx;
+    condition_variable wakeCv;
+    atomic<uint64_t> epoch{0};
+
+    void run(Worker* w) {
+        uint64_t seenEpoch = epoch.load();
+        while (running.load(memory_order_acquire)) {
+            bool didWork = false;
+            {
+                lock_guard<mutex> lock(w->mtx);
+                uint64_t seq;
+                for (auto& mb : w->mailboxes) {
+                    while (mb->queue.tryPop(seq)) {
+                        mb->subscriber->update();
+                        didWork = true;
+                    }
+                }
+            }
+            if (!didWork) {
+                unique_lock<mutex> lock(wakeMtx);
+                wakeCv.wait_for(lock, chrono::milliseconds(1), [&] {
+                    return epoch.load() != seenEpoch || !running.load();
+                });
+                seenEpoch = epoch.load();
+            }
+        }
+    }
+
+public:
+    explicit AsyncDispatcher(size_t workerCount) {
+        for (size_t i = 0; i < max<size_t>(workerCount, 1); i++) {
+            workers.push_back(make_unique<Worker>());
+        }
+        for (auto& w : workers) {
+            Worker* raw = w.get();
+            w->th = thread([this, raw] { run(raw); });
+        }
+    }
+
+    ~AsyncDispatcher() {
+        running.store(false, memory_order_release);
+        wake();
+        for (auto& w : workers) {
+            w->th.join();
+        }
+    }
+
+    void attach(const shared_ptr<Mailbox>& mb) {
+        Worker* w = workers[nextWorker.fetch_add(1) % workers.size()].get();
+        lock_guard<mutex> lock(w->mtx);
+        w->mailboxes.push_back(mb);
+    }
+
+    void detach(const shared_ptr<Mailbox>& mb) {
+        for (auto& w : workers) {
+            lock_guard<mutex> lock(w->mtx);
+            auto it = find(w->mailboxes.begin(), w->mailboxes.end(), mb);
+            if (it != w->mailboxes.end()) {
+                w->mailboxes.erase(it);
+                return;
+            }
+        }
+    }
+
+    // One wake-up per publish, not per subscriber.
+    void wake() {
+        epoch.fetch_add(1);
+        wakeCv.notify_all();
+    }
+
+    // Blocks until every attached mailbox is empty and no update() is in flight.
+    void waitIdle() {
+        for (auto& w : workers) {
+            while (true) {
+                {
+                    lock_guard<mutex> lock(w->mtx);
+                    bool allEmpty = true;
+                    for (auto& mb : w->mailboxes) {
+                        if (!mb->queue.empty()) {
+                            allEmpty = false;
+                            break;
+                        }
+                    }
+                    if (allEmpty) {
+                        break;
+                    }
+                }
+                wake();
+                this_thread::yield();
+            }
+        }
+    }
+};
+
+// Concrete Subject (Channel)
+// Without a dispatcher it behaves exactly like main.cpp (synchronous update() calls).
+// uploadVideo() must be called from a single publisher thread: it is the producer of every mailbox.
+class Channel : public IChannel {
+private:
+    vector<shared_ptr<Mailbox>> mailboxes;
+    mutex subscribersMtx;
+    string channelName;
+    string latestVideo;
+    AsyncDispatcher* dispatcher;
+    BackpressurePolicy policy;
+    size_t mailboxCapacity;
+    uint64_t uploadSeq = 0;
+
+public:
+    Channel(string name, AsyncDispatcher* dispatcher = nullptr,
+            BackpressurePolicy policy = BackpressurePolicy::DropOldest, size_t mailboxCapacity = 64)
+        : channelName(name), dispatcher(dispatcher), policy(policy), mailboxCapacity(mailboxCapacity) {}
+
+    ~Channel() {
+        if (dispatcher) {
+            for (auto& mb : mailboxes) {
+                dispatcher->detach(mb);
+            }
+        }
+    }
+
+    void subscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(subscribersMtx);
+        for (auto& mb : mailboxes) {
+            if (mb->subscriber == subscriber) {
+                return;
+            }
+        }
+        auto mb = make_shared<Mailbox>(subscriber, mailboxCapacity);
+        mailboxes.push_back(mb);
+        if (dispatcher) {
+            dispatcher->attach(mb);
+        }
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(subscribersMtx);
+        auto it = find_if(mailboxes.begin(), mailboxes.end(),
+                          [&](const shared_ptr<Mailbox>& mb) { return mb->subscriber == subscriber; });
+        if (it != mailboxes.end()) {
+            if (dispatcher) {
+                dispatcher->detach(*it);
+            }
+            mailboxes.erase(it);
+        }
+    }
+
+    void notify() override {
+        lock_guard<mutex> lock(subscribersMtx);
+        uint64_t seq = ++uploadSeq;
+        if (!dispatcher) {
+            for (auto& mb : mailboxes) {
+                mb->subscriber->update();
+            }
+            return;
+        }
+        for (auto& mb : mailboxes) {
+            switch (policy) {
+            case BackpressurePolicy::DropOldest:
+                if (mb->queue.pushDropOldest(seq)) {
+                    mb->dropped.fetch_add(1, memory_order_relaxed);
+                }
+                break;
+            case BackpressurePolicy::Block:
+                while (!mb->queue.tryPush(seq)) {
+                    dispatcher->wake();
+                    this_thread::yield();
+                }
+                break;
+            case BackpressurePolicy::Coalesce:
+                if (mb->queue.empty()) {
+                    mb->queue.tryPush(seq);
+                } else {
+                    mb->dropped.fetch_add(1, memory_order_relaxed);
+                }
+                break;
+            }
+        }
+        dispatcher->wake();
+    }
+
+    void uploadVideo() {
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+
+    const string& getName() const {
+        return channelName;
+    }
+
+    uint64_t droppedNotifications() {
+        lock_guard<mutex> lock(subscribersMtx);
+        uint64_t total = 0;
+        for (auto& mb : mailboxes) {
+            total += mb->dropped.load(memory_order_relaxed);
+        }
+        return total;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+// Benchmark observer: a small amount of CPU work per update.
+class WorkingSubscriber : public ISubscriber {
+private:
+    uint64_t state = 1;
+
+public:
+    atomic<uint64_t> updates{0};
+
+    void update() override {
+        for (int i = 0; i < 32; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+        updates.fetch_add(1, memory_order_relaxed);
+    }
+};
+
+// Benchmark observer: the one slow subscriber that stalls everyone in sync mode.
+class SlowSubscriber : public ISubscriber {
+public:
+    void update() override {
+        this_thread::sleep_for(chrono::milliseconds(1));
+    }
+};
+
+static void runLatencyBenchmark(const string& label, AsyncDispatcher* dispatcher, BackpressurePolicy policy) {
+    const int subscriberCount = 10000;
+    const int uploads = 200;
+
+    Channel channel("Bench", dispatcher, policy);
+    vector<unique_ptr<WorkingSubscriber>> subs;
+    for (int i = 0; i < subscriberCount; i++) {
+        subs.push_back(make_unique<WorkingSubscriber>());
+        channel.subscribe(subs.back().get());
+    }
+    SlowSubscriber slow;
+    channel.subscribe(&slow);
+
+    vector<double> latenciesUs;
+    latenciesUs.reserve(uploads);
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < uploads; i++) {
+        auto t0 = chrono::steady_clock::now();
+        channel.uploadVideo();
+        auto t1 = chrono::steady_clock::now();
+        latenciesUs.push_back(chrono::duration<double, micro>(t1 - t0).count());
+    }
+    double publishMs = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+    if (dispatcher) {
+        dispatcher->waitIdle();
+    }
+
+    uint64_t delivered = 0;
+    for (auto& s : subs) {
+        delivered += s->updates.load();
+    }
+    uint64_t dropped = channel.droppedNotifications();
+    if (dispatcher) {
+        for (auto& s : subs) {
+            channel.unsubscribe(s.get());
+        }
+        channel.unsubscribe(&slow);
+    }
+
+    sort(latenciesUs.begin(), latenciesUs.end());
+    cout << "  " << label
+         << " | p50 " << latenciesUs[latenciesUs.size() / 2] << " us"
+         << " | p99 " << latenciesUs[latenciesUs.size() * 99 / 100] << " us"
+         << " | publish total " << publishMs << " ms"
+         << " | delivered " << delivered << " | dropped/coalesced " << dropped << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    {
+        AsyncDispatcher dispatcher(2);
+        Channel myChannel("Tech Insights", &dispatcher, BackpressurePolicy::Block);
+
+        Subscriber sub1("Alice");
+        Subscriber sub2("Bob");
+
+        myChannel.subscribe(&sub1);
+        myChannel.subscribe(&sub2);
+
+        myChannel.setVideo("Observer Design Pattern Explained");
+        cout << "Uploading to " << myChannel.getName() << " (async)..." << endl;
+        myChannel.uploadVideo();
+        dispatcher.waitIdle();
+
+        myChannel.unsubscribe(&sub1);
+
+        myChannel.setVideo("Understanding Dependency Injection");
+        cout << "Uploading to " << myChannel.getName() << " (async)..." << endl;
+        myChannel.uploadVideo();
+        dispatcher.waitIdle();
+    }
+
+    cout << "\nPublish latency, 10000 subscribers + 1 slow subscriber (1 ms per update):" << endl;
+    runLatencyBenchmark("sync            ", nullptr, BackpressurePolicy::DropOldest);
+    {
+        AsyncDispatcher dispatcher(thread::hardware_concurrency());
+        runLatencyBenchmark("async DropOldest", &dispatcher, BackpressurePolicy::DropOldest);
+        runLatencyBenchmark("async Coalesce  ", &dispatcher, BackpressurePolicy::Coalesce);
+        runLatencyBenchmark("async Block     ", &dispatcher, BackpressurePolicy::Block);
+    }
+
+    return 0;
+}
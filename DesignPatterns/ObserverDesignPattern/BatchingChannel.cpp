@@ -0,0 +1,240 @@
+/*
+Batching Observer (coalesced notifications):
+
+In main.cpp every uploadVideo() runs a full notify() pass: one virtual update() call per
+subscriber per upload. A channel that uploads in bursts pays for N passes over the whole
+subscriber list, touching every subscriber object N times.
+
+BatchingChannel adds an opt-in batching mode:
+
+- uploadVideo() appends the event to a pending batch instead of notifying right away.
+- The batch is delivered when it reaches `maxBatchSize` events, or when the oldest pending
+  event is older than `maxDelay` (checked on the next uploadVideo() or poll()), or on flush().
+- Each subscriber then gets ONE update() call carrying every event in the batch.
+- With BatchPolicy::immediate() the channel behaves like main.cpp: one event per update().
+
+There is no timer thread: a caller that can go quiet should call poll() from its own loop,
+or flush() before shutting down.
+
+   uploadVideo() x N ──> pending batch ──(size or age limit)──> update(batch) x subscribers
+
+main() runs the usual demo and then compares events/sec and update() callback counts with
+and without batching.
+
+Build: g++ -std=c++17 -O2 BatchingChannel.cpp -o BatchingChannel
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+using namespace std;
+
+struct VideoEvent {
+    string title;
+    uint64_t sequence;
+};
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface. `events` holds one or more uploads, oldest first.
+class ISubscriber {
+public:
+    virtual void update(const vector<VideoEvent>& events) = 0;
+    virtual ~ISubscriber() {}
+};
+
+struct BatchPolicy {
+    size_t maxBatchSize;
+    chrono::steady_clock::duration maxDelay;
+
+    static BatchPolicy immediate() {
+        return {1, chrono::steady_clock::duration::zero()};
+    }
+
+    static BatchPolicy coalesce(size_t maxBatchSize, chrono::steady_clock::duration maxDelay) {
+        return {max<size_t>(maxBatchSize, 1), maxDelay};
+    }
+};
+
+// Concrete Subject (Channel)
+class BatchingChannel : public IChannel {
+private:
+    vector<ISubscriber*> subscribers;
+    string channelName;
+    string latestVideo;
+    BatchPolicy policy;
+    vector<VideoEvent> pending;   // reused between batches, so steady state does not allocate
+    chrono::steady_clock::time_point oldestPending;
+    uint64_t uploadSeq = 0;
+
+    bool batchDue(chrono::steady_clock::time_point now) const {
+        return pending.size() >= policy.maxBatchSize || now - oldestPending >= policy.maxDelay;
+    }
+
+public:
+    BatchingChannel(string name, BatchPolicy policy = BatchPolicy::immediate())
+        : channelName(name), policy(policy) {
+        pending.reserve(policy.maxBatchSize);
+    }
+
+    void subscribe(ISubscriber* subscriber) override {
+        for (auto sub : subscribers) {
+            if (sub == subscriber) {
+                return;
+            }
+        }
+        subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+
+    // Delivers the pending batch, if any.
+    void notify() override {
+        if (pending.empty()) {
+            return;
+        }
+        for (auto sub : subscribers) {
+            sub->update(pending);
+        }
+        pending.clear();
+    }
+
+    void flush() {
+        notify();
+    }
+
+    // Delivers the pending batch if it has waited longer than maxDelay.
+    void poll() {
+        if (!pending.empty() && batchDue(chrono::steady_clock::now())) {
+            notify();
+        }
+    }
+
+    void uploadVideo() {
+        auto now = chrono::steady_clock::now();
+        if (pending.empty()) {
+            oldestPending = now;
+        }
+        pending.push_back({latestVideo, ++uploadSeq});
+        if (batchDue(now)) {
+            notify();
+        }
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update(const vector<VideoEvent>& events) override {
+        cout << "Subscriber " << subscriberName << " notified of " << events.size() << " new video(s):";
+        for (auto& e : events) {
+            cout << " \"" << e.title << "\"";
+        }
+        cout << endl;
+    }
+};
+
+// Benchmark observer: per-event work plus a per-call counter.
+class CountingSubscriber : public ISubscriber {
+public:
+    uint64_t calls = 0;
+    uint64_t events = 0;
+    uint64_t checksum = 0;
+
+    void update(const vector<VideoEvent>& batch) override {
+        calls++;
+        events += batch.size();
+        for (auto& e : batch) {
+            checksum += e.sequence ^ e.title.size();
+        }
+    }
+};
+
+static void runBenchmark(const string& label, BatchPolicy policy) {
+    const int subscriberCount = 1000;
+    const int uploads = 100000;
+
+    BatchingChannel channel("Bench", policy);
+    vector<CountingSubscriber> subs(subscriberCount);
+    for (auto& s : subs) {
+        channel.subscribe(&s);
+    }
+    channel.setVideo("Batching and Coalescing Explained");
+
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < uploads; i++) {
+        channel.uploadVideo();
+    }
+    channel.flush();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    uint64_t calls = 0, events = 0;
+    for (auto& s : subs) {
+        calls += s.calls;
+        events += s.events;
+    }
+    cout << "  " << label << " | " << uint64_t(uploads / seconds) << " uploads/s | "
+         << uint64_t(events / seconds) << " events delivered/s | " << calls << " update() calls" << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    BatchingChannel* myChannel = new BatchingChannel("Tech Insights", BatchPolicy::coalesce(3, chrono::seconds(1)));
+
+    Subscriber* sub1 = new Subscriber("Alice");
+    Subscriber* sub2 = new Subscriber("Bob");
+
+    myChannel->subscribe(sub1);
+    myChannel->subscribe(sub2);
+
+    myChannel->setVideo("Observer Design Pattern Explained");
+    myChannel->uploadVideo();
+    myChannel->setVideo("Strategy Design Pattern Explained");
+    myChannel->uploadVideo();
+    myChannel->setVideo("Factory Design Pattern Explained");
+    myChannel->uploadVideo();   // third upload fills the batch
+
+    myChannel->unsubscribe(sub1);
+
+    myChannel->setVideo("Understanding Dependency Injection");
+    myChannel->uploadVideo();
+    myChannel->flush();
+
+    delete sub1;
+    delete sub2;
+    delete myChannel;
+
+    cout << "\n1000 subscribers, 100000 uploads:" << endl;
+    runBenchmark("immediate          ", BatchPolicy::immediate());
+    runBenchmark("batch 16 / 10 ms   ", BatchPolicy::coalesce(16, chrono::milliseconds(10)));
+    runBenchmark("batch 256 / 10 ms  ", BatchPolicy::coalesce(256, chrono::milliseconds(10)));
+
+    return 0;
+}
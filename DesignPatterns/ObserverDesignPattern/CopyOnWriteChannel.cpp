@@ -0,0 +1,406 @@
+/*
+Copy-On-Write Observer (lock-free notify):
+
+main.cpp mutates `vector<ISubscriber*> subscribers` in place, so notify() running on one
+thread while another thread calls subscribe()/unsubscribe() is a data race. The usual fix is
+one mutex around the whole channel, which makes every notify() wait behind churn.
+
+Here the subscriber list is an immutable snapshot published through an atomic pointer (RCU):
+
+- notify()        -> enter a read-side critical section, load the current snapshot, iterate it.
+                     No locks and no allocations.
+- subscribe() /   -> copy the snapshot, modify the copy, atomically swap it in and retire the old
+  unsubscribe()      one. Writers serialize on a writer-only mutex that readers never touch.
+- Reclamation     -> epoch based. A reader publishes the global epoch in its own cache-line
+                     sized slot before loading the snapshot. A retired snapshot tagged with epoch
+                     R is freed once no reader slot holds an epoch <= R.
+
+          readers (notify)                          writers (subscribe / unsubscribe)
+   slot = epoch ──> load snapshot ──> iterate      copy ──> modify ──> swap ──> retire old
+                                                                                   │
+                         freed when every active slot has moved past it  <─────────┘
+
+main() runs the usual demo and then a stress benchmark: 16 threads concurrently
+subscribing, unsubscribing and notifying, compared with a mutex-wrapped Channel.
+
+Build: g++ -std=c++17 -O2 -pthread CopyOnWriteChannel.cpp -o CopyOnWriteChannel
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update() = 0;
+    virtual ~ISubscriber() {}
+};
+
+// Epoch-based reclamation shared by every CopyOnWriteChannel.
+class EpochDomain {
+public:
+    static const int MaxThreads = 256;
+
+private:
+    struct alignas(64) ReaderSlot {
+        atomic<uint64_t> epoch{0};   // 0 = quiescent
+        atomic<bool> owned{false};
+    };
+
+    ReaderSlot slots[MaxThreads];
+    atomic<uint64_t> globalEpoch{1};
+
+    // Each thread claims one slot on first use and gives it back when it exits.
+    struct ThreadState {
+        EpochDomain* domain = nullptr;
+        int slot = -1;
+        int depth = 0;
+
+        ~ThreadState() {
+            if (domain && slot >= 0) {
+                domain->slots[slot].owned.store(false, memory_order_release);
+            }
+        }
+    };
+
+    ThreadState& threadState() {
+        thread_local ThreadState state;
+        if (state.slot < 0) {
+            for (int i = 0; i < MaxThreads; i++) {
+                bool expected = false;
+                if (slots[i].owned.compare_exchange_strong(expected, true)) {
+                    state.domain = this;
+                    state.slot = i;
+                    break;
+                }
+            }
+            if (state.slot < 0) {
+                cerr << "EpochDomain: more than " << MaxThreads << " reader threads" << endl;
+                terminate();
+            }
+        }
+        return state;
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Read-side critical sections may nest (an update() that notifies another channel).
+    void enter() {
+        ThreadState& state = threadState();
+        if (state.depth++ == 0) {
+            slots[state.slot].epoch.store(globalEpoch.load(memory_order_relaxed), memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        ThreadState& state = threadState();
+        if (--state.depth == 0) {
+            slots[state.slot].epoch.store(0, memory_order_release);
+        }
+    }
+
+    // Called by writers after unpublishing an object. Returns the epoch it was retired in.
+    uint64_t retireEpoch() {
+        return globalEpoch.fetch_add(1, memory_order_seq_cst);
+    }
+
+    // True once no reader can still see an object retired in `epoch`.
+    bool isSafe(uint64_t epoch) const {
+        for (int i = 0; i < MaxThreads; i++) {
+            uint64_t e = slots[i].epoch.load(memory_order_seq_cst);
+            if (e != 0 && e <= epoch) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// RAII read-side guard.
+class ReadGuard {
+public:
+    ReadGuard() { EpochDomain::instance().enter(); }
+    ~ReadGuard() { EpochDomain::instance().exit(); }
+};
+
+// Concrete Subject (Channel) whose notify() is safe against concurrent subscribe/unsubscribe.
+class CopyOnWriteChannel : public IChannel {
+private:
+    using Snapshot = vector<ISubscriber*>;
+
+    struct Retired {
+        Snapshot* snapshot;
+        uint64_t epoch;
+    };
+
+    atomic<Snapshot*> subscribers;
+    mutex writerMtx;             // serializes writers only, never taken by notify()
+    vector<Retired> retired;     // guarded by writerMtx
+    string channelName;
+    string latestVideo;
+
+    // Must hold writerMtx.
+    void publish(Snapshot* next) {
+        Snapshot* old = subscribers.exchange(next, memory_order_seq_cst);
+        retired.push_back({old, EpochDomain::instance().retireEpoch()});
+        reclaim();
+    }
+
+    // Must hold writerMtx.
+    void reclaim() {
+        EpochDomain& domain = EpochDomain::instance();
+        size_t kept = 0;
+        for (auto& r : retired) {
+            if (domain.isSafe(r.epoch)) {
+                delete r.snapshot;
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    CopyOnWriteChannel(string name) : subscribers(new Snapshot()), channelName(name) {}
+
+    // No reader may still be inside notify() when the channel is destroyed.
+    ~CopyOnWriteChannel() {
+        for (auto& r : retired) {
+            delete r.snapshot;
+        }
+        delete subscribers.load();
+    }
+
+    void subscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(writerMtx);
+        Snapshot* current = subscribers.load(memory_order_relaxed);
+        if (find(current->begin(), current->end(), subscriber) != current->end()) {
+            return;
+        }
+        Snapshot* next = new Snapshot();
+        next->reserve(current->size() + 1);
+        *next = *current;
+        next->push_back(subscriber);
+        publish(next);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(writerMtx);
+        Snapshot* current = subscribers.load(memory_order_relaxed);
+        auto it = find(current->begin(), current->end(), subscriber);
+        if (it == current->end()) {
+            return;
+        }
+        Snapshot* next = new Snapshot();
+        next->reserve(current->size() - 1);
+        next->insert(next->end(), current->begin(), it);
+        next->insert(next->end(), it + 1, current->end());
+        publish(next);
+    }
+
+    void notify() override {
+        ReadGuard guard;
+        const Snapshot* snapshot = subscribers.load(memory_order_seq_cst);
+        for (ISubscriber* sub : *snapshot) {
+            sub->update();
+        }
+    }
+
+    void uploadVideo() {
+        cout << "New video \"" << latestVideo << "\" uploaded to channel: " << channelName << endl;
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+
+    size_t subscriberCount() {
+        ReadGuard guard;
+        return subscribers.load(memory_order_seq_cst)->size();
+    }
+
+    size_t pendingReclaim() {
+        lock_guard<mutex> lock(writerMtx);
+        reclaim();
+        return retired.size();
+    }
+};
+
+// The baseline: main.cpp's Channel wrapped in one mutex.
+class LockedChannel : public IChannel {
+private:
+    vector<ISubscriber*> subscribers;
+    mutex mtx;
+
+public:
+    void subscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(mtx);
+        if (find(subscribers.begin(), subscribers.end(), subscriber) == subscribers.end()) {
+            subscribers.push_back(subscriber);
+        }
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        lock_guard<mutex> lock(mtx);
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+
+    void notify() override {
+        lock_guard<mutex> lock(mtx);
+        for (auto sub : subscribers) {
+            sub->update();
+        }
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+// Benchmark observer. Updated from many threads at once, so the counter is atomic.
+class CountingSubscriber : public ISubscriber {
+public:
+    atomic<uint64_t> updates{0};
+
+    void update() override {
+        updates.fetch_add(1, memory_order_relaxed);
+    }
+};
+
+// 16 threads: `notifiers` threads call notify(), the rest churn subscribe/unsubscribe.
+static void runStress(const string& label, IChannel& channel, int notifiers, int churners,
+                      chrono::milliseconds duration) {
+    const int poolSize = 1024;
+    vector<CountingSubscriber> pool(poolSize);
+    for (int i = 0; i < poolSize / 2; i++) {
+        channel.subscribe(&pool[i]);
+    }
+
+    atomic<bool> stop{false};
+    atomic<uint64_t> notifyCalls{0};
+    atomic<uint64_t> churnOps{0};
+    vector<thread> threads;
+
+    for (int t = 0; t < notifiers; t++) {
+        threads.emplace_back([&] {
+            uint64_t calls = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                channel.notify();
+                calls++;
+            }
+            notifyCalls.fetch_add(calls);
+        });
+    }
+    for (int t = 0; t < churners; t++) {
+        threads.emplace_back([&, t] {
+            mt19937 rng(t + 1);
+            uniform_int_distribution<int> pick(0, poolSize - 1);
+            uint64_t ops = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                CountingSubscriber* sub = &pool[pick(rng)];
+                if (ops & 1) {
+                    channel.subscribe(sub);
+                } else {
+                    channel.unsubscribe(sub);
+                }
+                ops++;
+            }
+            churnOps.fetch_add(ops);
+        });
+    }
+
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& th : threads) {
+        th.join();
+    }
+    for (auto& sub : pool) {
+        channel.unsubscribe(&sub);
+    }
+
+    uint64_t updates = 0;
+    for (auto& sub : pool) {
+        updates += sub.updates.load();
+    }
+    double seconds = chrono::duration<double>(duration).count();
+    cout << "  " << label
+         << " | notify/s " << uint64_t(notifyCalls.load() / seconds)
+         << " | updates/s " << uint64_t(updates / seconds)
+         << " | subscribe+unsubscribe/s " << uint64_t(churnOps.load() / seconds) << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    CopyOnWriteChannel* myChannel = new CopyOnWriteChannel("Tech Insights");
+
+    Subscriber* sub1 = new Subscriber("Alice");
+    Subscriber* sub2 = new Subscriber("Bob");
+
+    myChannel->subscribe(sub1);
+    myChannel->subscribe(sub2);
+
+    myChannel->setVideo("Observer Design Pattern Explained");
+    myChannel->uploadVideo();
+
+    myChannel->unsubscribe(sub1);
+
+    myChannel->setVideo("Understanding Dependency Injection");
+    myChannel->uploadVideo();
+
+    delete sub1;
+    delete sub2;
+    delete myChannel;
+
+    const int notifiers = 8;
+    const int churners = 8;
+    const auto duration = chrono::milliseconds(1000);
+    cout << "\nStress: " << notifiers << " notify threads + " << churners
+         << " subscribe/unsubscribe threads, 1024 subscriber pool:" << endl;
+
+    CopyOnWriteChannel cow("Stress");
+    runStress("copy-on-write", cow, notifiers, churners, duration);
+    cout << "  copy-on-write snapshots still waiting for reclamation: " << cow.pendingReclaim()
+         << ", subscribers left: " << cow.subscriberCount() << endl;
+
+    LockedChannel locked;
+    runStress("mutex channel", locked, notifiers, churners, duration);
+
+    return 0;
+}
@@ -0,0 +1,606 @@
+/*
+Durable Observer (replayable event log):
+
+In main.cpp a Channel only remembers `latestVideo`. A subscriber that joins late, or
+restarts, has no way to see what it missed.
+
+DurableChannel writes every upload to an append-only log on disk before notifying:
+
+- The log is a list of fixed-size segment files (<channel>-<first offset>.log), each
+  memory-mapped. Appending is a memcpy into the mapping; a full segment is closed and a
+  new one is started.
+- Every record is [length][checksum][title bytes], padded to 8 bytes. Its offset is its
+  byte position in the whole log, so offsets only grow and survive restarts. Live and
+  replayed updates both get a string_view straight into the mapping.
+- Group commit: appends are not synced one by one. msync() runs when `maxRecords`
+  appends are pending or the oldest pending append is older than `maxDelay`, or on commit().
+  Records past durableOffset() can be lost if the machine crashes.
+- Subscribers keep the offset they want to read next. subscribe(sub, fromOffset) first
+  replays everything from that offset straight out of the mapped segments (update() gets
+  a string_view into the mapping, no copies) and then delivers live uploads.
+- Reopening a channel scans its segments and stops at the first empty or corrupt record.
+  The log is truncated there: the rest of that segment is zeroed and any later segments
+  are deleted, so offsets stay continuous. New segments (and deletions) are followed by
+  an fsync of the directory, so the file names survive a crash too.
+
+   uploadVideo() ──> append to mapped segment ──> notify live subscribers
+                          │
+                 group commit (msync)        late subscriber: replay(fromOffset) ──> update()
+
+POSIX only (mmap / msync). main() runs the usual demo plus a late subscriber, then measures
+append throughput with group commit and catch-up read throughput.
+
+Build: g++ -std=c++17 -O2 DurableChannel.cpp -o DurableChannel
+*/
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+using namespace std;
+namespace fs = std::filesystem;
+
+// What a subscriber receives. `title` points into the mapped log: valid during update() only.
+struct VideoRecord {
+    uint64_t offset;
+    uint64_t nextOffset;   // where a reader resumes after this record
+    string_view title;
+};
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update(const VideoRecord& record) = 0;
+    virtual ~ISubscriber() {}
+};
+
+// One memory-mapped segment file.
+class Segment {
+private:
+    struct RecordHeader {
+        uint32_t length;     // 0 marks the end of the written part
+        uint32_t checksum;   // FNV-1a of the payload
+    };
+
+    fs::path path;
+    int fd = -1;
+    char* data = nullptr;
+    size_t capacity = 0;
+    size_t used = 0;
+
+    static uint32_t checksumOf(string_view payload) {
+        uint32_t h = 2166136261u;
+        for (unsigned char c : payload) {
+            h = (h ^ c) * 16777619u;
+        }
+        return h | 1;   // never 0, so an all-zero header is never valid
+    }
+
+    static size_t recordSize(size_t payloadLength) {
+        return (sizeof(RecordHeader) + payloadLength + 7) & ~size_t(7);
+    }
+
+    Segment(fs::path path, uint64_t baseOffset) : path(move(path)), baseOffset(baseOffset) {}
+
+    void map(int flags, size_t size, bool resize) {
+        fd = ::open(path.c_str(), flags, 0644);
+        if (fd < 0) {
+            throw runtime_error("cannot open " + path.string());
+        }
+        if (resize && ftruncate(fd, off_t(size)) != 0) {
+            throw runtime_error("cannot size " + path.string());
+        }
+        capacity = size;
+        void* p = mmap(nullptr, capacity, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            throw runtime_error("cannot map " + path.string());
+        }
+        data = static_cast<char*>(p);
+    }
+
+public:
+    const uint64_t baseOffset;
+
+    static unique_ptr<Segment> create(const fs::path& path, uint64_t baseOffset, size_t capacity) {
+        unique_ptr<Segment> segment(new Segment(path, baseOffset));
+        segment->map(O_RDWR | O_CREAT | O_TRUNC, capacity, true);
+        fsync(segment->fd);
+        return segment;
+    }
+
+    // Reopens an existing segment and finds the end of its valid records. Anything after the
+    // first bad record is zeroed, so stale bytes there can never be read as records later.
+    // A 0-byte file (crash right after creation) is sized to `capacity`.
+    static unique_ptr<Segment> open(const fs::path& path, uint64_t baseOffset, size_t capacity) {
+        unique_ptr<Segment> segment(new Segment(path, baseOffset));
+        size_t fileSize = fs::file_size(path);
+        segment->map(O_RDWR, fileSize == 0 ? capacity : fileSize, fileSize == 0);
+        bool corrupt = false;
+        while (true) {
+            size_t pos = segment->used;
+            if (pos + sizeof(RecordHeader) > segment->capacity) {
+                break;
+            }
+            RecordHeader header;
+            memcpy(&header, segment->data + pos, sizeof(header));
+            if (header.length == 0 && header.checksum == 0) {
+                break;   // clean end
+            }
+            if (header.length == 0 || pos + recordSize(header.length) > segment->capacity ||
+                header.checksum != checksumOf({segment->data + pos + sizeof(header), header.length})) {
+                corrupt = true;
+                break;
+            }
+            segment->used += recordSize(header.length);
+        }
+        if (corrupt) {
+            memset(segment->data + segment->used, 0, segment->capacity - segment->used);
+            segment->sync(segment->used, segment->capacity);
+        }
+        return segment;
+    }
+
+    ~Segment() {
+        if (data) {
+            munmap(data, capacity);
+        }
+        if (fd >= 0) {
+            ::close(fd);
+        }
+    }
+
+    size_t size() const { return used; }
+    uint64_t endOffset() const { return baseOffset + used; }
+
+    bool fits(size_t payloadLength) const {
+        return used + recordSize(payloadLength) <= capacity;
+    }
+
+    // Caller checks fits() first. The header is written last, so a torn append fails the checksum.
+    VideoRecord append(string_view payload) {
+        char* dst = data + used;
+        memcpy(dst + sizeof(RecordHeader), payload.data(), payload.size());
+        RecordHeader header{uint32_t(payload.size()), checksumOf(payload)};
+        memcpy(dst, &header, sizeof(header));
+        uint64_t offset = baseOffset + used;
+        used += recordSize(payload.size());
+        return {offset, baseOffset + used, string_view(dst + sizeof(RecordHeader), payload.size())};
+    }
+
+    // Flushes [from, to) (segment-relative) to disk.
+    void sync(size_t from, size_t to) {
+        if (from >= to) {
+            return;
+        }
+        size_t page = size_t(sysconf(_SC_PAGESIZE));
+        size_t start = from & ~(page - 1);
+        msync(data + start, to - start, MS_SYNC);
+    }
+
+    // Calls fn(record) for every record in [offset, end). Returns the offset after the last one.
+    template <typename Fn>
+    uint64_t read(uint64_t offset, Fn&& fn) const {
+        size_t pos = size_t(offset - baseOffset);
+        while (pos < used) {
+            RecordHeader header;
+            memcpy(&header, data + pos, sizeof(header));
+            size_t next = pos + recordSize(header.length);
+            fn(VideoRecord{baseOffset + pos, baseOffset + next, string_view(data + pos + sizeof(header), header.length)});
+            pos = next;
+        }
+        return baseOffset + pos;
+    }
+};
+
+struct GroupCommit {
+    size_t maxRecords;
+    chrono::steady_clock::duration maxDelay;
+};
+
+// Append-only log made of segments. Logical offsets run continuously across segments.
+class SegmentLog {
+private:
+    fs::path directory;
+    string name;
+    size_t segmentCapacity;
+    vector<unique_ptr<Segment>> segments;
+    uint64_t durable = 0;
+    uint64_t syncCalls = 0;
+
+    fs::path segmentPath(uint64_t baseOffset) const {
+        string digits = to_string(baseOffset);
+        return directory / (name + "-" + string(20 - digits.size(), '0') + digits + ".log");
+    }
+
+    // The base offset of a "<name>-<20 digits>.log" file. Any other name is not a segment of
+    // this log and is left alone.
+    bool parseSegmentName(const string& file, uint64_t& base) const {
+        size_t digitsAt = name.size() + 1;
+        if (file.size() != digitsAt + 24 || file.compare(0, name.size(), name) != 0 || file[name.size()] != '-' ||
+            file.compare(digitsAt + 20, 4, ".log") != 0) {
+            return false;
+        }
+        const char* first = file.data() + digitsAt;
+        const char* last = first + 20;
+        if (!all_of(first, last, [](char c) { return c >= '0' && c <= '9'; })) {
+            return false;
+        }
+        auto [end, error] = from_chars(first, last, base);
+        return error == errc() && end == last;
+    }
+
+    // Makes file creations and deletions in the log directory durable.
+    void syncDirectory() const {
+        int fd = ::open(directory.c_str(), O_RDONLY | O_DIRECTORY);
+        if (fd >= 0) {
+            fsync(fd);
+            ::close(fd);
+        }
+    }
+
+    void roll() {
+        commit();
+        segments.push_back(Segment::create(segmentPath(endOffset()), endOffset(), segmentCapacity));
+        syncDirectory();
+    }
+
+public:
+    SegmentLog(fs::path directory, string name, size_t segmentCapacity)
+        : directory(move(directory)), name(move(name)), segmentCapacity(segmentCapacity) {
+        fs::create_directories(this->directory);
+        vector<pair<uint64_t, fs::path>> existing;
+        for (auto& entry : fs::directory_iterator(this->directory)) {
+            uint64_t base;
+            if (parseSegmentName(entry.path().filename().string(), base)) {
+                existing.push_back({base, entry.path()});
+            }
+        }
+        sort(existing.begin(), existing.end());
+        // Offsets must run on without gaps. A segment that ends early (corrupt record) or
+        // starts somewhere else ends the log: later segments are dropped.
+        bool dropped = false;
+        for (auto& e : existing) {
+            if (dropped || (segments.empty() ? e.first != 0 : e.first != endOffset())) {
+                fs::remove(e.second);
+                dropped = true;
+                continue;
+            }
+            segments.push_back(Segment::open(e.second, e.first, segmentCapacity));
+        }
+        if (segments.empty()) {
+            segments.push_back(Segment::create(segmentPath(0), 0, segmentCapacity));
+            dropped = true;
+        }
+        if (dropped) {
+            syncDirectory();
+        }
+        durable = endOffset();
+    }
+
+    ~SegmentLog() {
+        commit();
+    }
+
+    uint64_t endOffset() const { return segments.back()->endOffset(); }
+    uint64_t durableOffset() const { return durable; }
+    uint64_t syncCount() const { return syncCalls; }
+    size_t segmentCount() const { return segments.size(); }
+
+    VideoRecord append(string_view payload) {
+        if (!segments.back()->fits(payload.size())) {
+            if (payload.size() + 64 > segmentCapacity) {
+                throw length_error("record larger than a segment");
+            }
+            roll();
+        }
+        return segments.back()->append(payload);
+    }
+
+    // Syncs everything appended since the last commit.
+    void commit() {
+        uint64_t end = endOffset();
+        if (durable == end) {
+            return;
+        }
+        for (auto& s : segments) {
+            if (s->endOffset() > durable) {
+                uint64_t from = max(durable, s->baseOffset) - s->baseOffset;
+                s->sync(size_t(from), s->size());
+            }
+        }
+        durable = end;
+        syncCalls++;
+    }
+
+    // Replays records in [offset, end) in order. Returns the next offset to read.
+    template <typename Fn>
+    uint64_t read(uint64_t offset, Fn&& fn) const {
+        auto it = upper_bound(segments.begin(), segments.end(), offset,
+                              [](uint64_t off, const unique_ptr<Segment>& s) { return off < s->baseOffset; });
+        if (it != segments.begin()) {
+            --it;
+        }
+        for (; it != segments.end(); ++it) {
+            offset = (*it)->read(max(offset, (*it)->baseOffset), fn);
+        }
+        return offset;
+    }
+};
+
+// Concrete Subject (Channel)
+class DurableChannel : public IChannel {
+private:
+    vector<ISubscriber*> subscribers;
+    string channelName;
+    string latestVideo;
+    SegmentLog log;
+    GroupCommit groupCommit;
+    size_t pendingRecords = 0;
+    chrono::steady_clock::time_point oldestPending;
+    VideoRecord lastRecord{0, 0, {}};
+    bool hasRecord = false;   // nothing to deliver before the first upload
+
+public:
+    DurableChannel(string name, fs::path directory, GroupCommit groupCommit,
+                   size_t segmentCapacity = 64 << 20)
+        : channelName(name), log(directory, name, segmentCapacity), groupCommit(groupCommit) {}
+
+    // Live delivery only, starting with the next upload.
+    void subscribe(ISubscriber* subscriber) override {
+        for (auto sub : subscribers) {
+            if (sub == subscriber) {
+                return;
+            }
+        }
+        subscribers.push_back(subscriber);
+    }
+
+    // Replays everything from `fromOffset`, then switches to live delivery.
+    void subscribe(ISubscriber* subscriber, uint64_t fromOffset) {
+        replay(subscriber, fromOffset);
+        subscribe(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+
+    void notify() override {
+        if (!hasRecord) {
+            return;
+        }
+        for (auto sub : subscribers) {
+            sub->update(lastRecord);
+        }
+    }
+
+    uint64_t replay(ISubscriber* subscriber, uint64_t fromOffset) const {
+        return log.read(fromOffset, [&](const VideoRecord& record) { subscriber->update(record); });
+    }
+
+    void uploadVideo() {
+        auto now = chrono::steady_clock::now();
+        if (pendingRecords == 0) {
+            oldestPending = now;
+        }
+        lastRecord = log.append(latestVideo);
+        hasRecord = true;
+        if (++pendingRecords >= groupCommit.maxRecords || now - oldestPending >= groupCommit.maxDelay) {
+            commit();
+        }
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+
+    void commit() {
+        log.commit();
+        pendingRecords = 0;
+    }
+
+    const SegmentLog& getLog() const {
+        return log;
+    }
+};
+
+// Concrete Observer (Subscriber). Remembers where to resume after a restart.
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+    uint64_t nextOffset = 0;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update(const VideoRecord& record) override {
+        cout << "Subscriber " << subscriberName << " got \"" << record.title << "\" @" << record.offset << endl;
+        nextOffset = record.nextOffset;
+    }
+
+    uint64_t resumeOffset() const {
+        return nextOffset;
+    }
+};
+
+class CountingSubscriber : public ISubscriber {
+public:
+    uint64_t records = 0;
+    uint64_t bytes = 0;
+
+    void update(const VideoRecord& record) override {
+        records++;
+        bytes += record.title.size();
+    }
+};
+
+// Main function to test the pattern
+int main() {
+    fs::path root = fs::temp_directory_path() / ("durable_channel_demo_" + to_string(getpid()));
+    GroupCommit everyUpload{1, chrono::steady_clock::duration::zero()};
+
+    {
+        DurableChannel myChannel("TechInsights", root, everyUpload);
+        Subscriber sub1("Alice");
+        myChannel.subscribe(&sub1);
+
+        myChannel.setVideo("Observer Design Pattern Explained");
+        myChannel.uploadVideo();
+        myChannel.setVideo("Understanding Dependency Injection");
+        myChannel.uploadVideo();
+    }
+
+    // "Restart": reopen the channel from disk. Bob joins late and catches up from offset 0.
+    {
+        DurableChannel myChannel("TechInsights", root, everyUpload);
+        Subscriber sub2("Bob");
+        cout << "Bob catching up from offset 0:" << endl;
+        myChannel.subscribe(&sub2, 0);
+
+        myChannel.setVideo("Strategy Pattern in Practice");
+        myChannel.uploadVideo();
+        cout << "Bob will resume from offset " << sub2.resumeOffset() << endl;
+    }
+
+    // Crash recovery: a corrupt record in the first of several segments ends the log there,
+    // and a 0-byte segment left by a crash right after creation is usable.
+    {
+        struct OffsetCollector : ISubscriber {
+            vector<uint64_t> offsets;
+            void update(const VideoRecord& record) override { offsets.push_back(record.offset); }
+        };
+
+        OffsetCollector written;
+        size_t segmentsBefore;
+        {
+            DurableChannel channel("Recover", root, everyUpload, 4096);
+            for (int i = 0; i < 300; i++) {
+                channel.setVideo("recovery-event-" + to_string(i));
+                channel.uploadVideo();
+            }
+            segmentsBefore = channel.getLog().segmentCount();
+            channel.replay(&written, 0);
+        }
+
+        // Flip one payload byte of record #10, which lives in the first segment.
+        const size_t bad = 10;
+        fs::path first = root / "Recover-00000000000000000000.log";
+        int fd = ::open(first.c_str(), O_RDWR);
+        char byte = 0;
+        off_t at = off_t(written.offsets[bad] + 8);
+        bool flipped = fd >= 0 && pread(fd, &byte, 1, at) == 1;
+        byte ^= 0x5a;
+        flipped = flipped && pwrite(fd, &byte, 1, at) == 1;
+        if (fd >= 0) {
+            ::close(fd);
+        }
+
+        OffsetCollector kept;
+        DurableChannel reopened("Recover", root, everyUpload, 4096);
+        reopened.replay(&kept, 0);
+        bool recovered = flipped && kept.offsets.size() == bad && reopened.getLog().segmentCount() == 1 &&
+                         reopened.getLog().endOffset() == written.offsets[bad];
+        cout << "Recovery: " << segmentsBefore << " segments, record #" << bad << " corrupted -> "
+             << kept.offsets.size() << " records kept in " << reopened.getLog().segmentCount()
+             << " segment, end offset " << reopened.getLog().endOffset() << (recovered ? " (ok)" : " (FAILED)")
+             << endl;
+
+        ::close(::open((root / "Empty-00000000000000000000.log").c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+        DurableChannel empty("Empty", root, everyUpload, 4096);
+        empty.setVideo("first after crash");
+        empty.uploadVideo();
+        OffsetCollector emptyRecords;
+        empty.replay(&emptyRecords, 0);
+        bool emptyOk = emptyRecords.offsets.size() == 1;
+        cout << "0-byte segment reopened: " << (emptyOk ? "ok" : "FAILED") << endl;
+
+        // Files that only look like segments are skipped, not parsed or deleted.
+        {
+            DurableChannel stray("Stray", root, everyUpload, 4096);
+            stray.setVideo("only record");
+            stray.uploadVideo();
+        }
+        const char* strayNames[] = {"Stray-abcdefghijklmnopqrst.log", "Stray-000000000000000000x1.log",
+                                    "Stray-99999999999999999999.log", "Stray+00000000000000000001.log"};
+        for (const char* n : strayNames) {
+            ::close(::open((root / n).c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644));
+        }
+        bool strayOk = false;
+        try {
+            DurableChannel reopenedStray("Stray", root, everyUpload, 4096);
+            OffsetCollector strayRecords;
+            reopenedStray.replay(&strayRecords, 0);
+            strayOk = strayRecords.offsets.size() == 1 && reopenedStray.getLog().segmentCount() == 1;
+        } catch (const exception& e) {
+            cout << "  " << e.what() << endl;
+        }
+        for (const char* n : strayNames) {
+            strayOk = strayOk && fs::exists(root / n);
+        }
+        cout << "Foreign files next to the log skipped: " << (strayOk ? "ok" : "FAILED") << endl;
+        if (!recovered || !emptyOk || !strayOk) {
+            fs::remove_all(root);
+            return 1;
+        }
+    }
+
+    // Append and catch-up throughput.
+    const uint64_t events = 2000000;
+    GroupCommit batched{8192, chrono::milliseconds(5)};
+    double appendSeconds, readSeconds;
+    uint64_t syncs, segmentsUsed;
+    CountingSubscriber reader;
+    {
+        DurableChannel channel("Bench", root, batched);
+        channel.setVideo("video-title-0123456789-abcdefghi");   // 32 bytes
+        auto start = chrono::steady_clock::now();
+        for (uint64_t i = 0; i < events; i++) {
+            channel.uploadVideo();
+        }
+        channel.commit();
+        appendSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+        syncs = channel.getLog().syncCount();
+        segmentsUsed = channel.getLog().segmentCount();
+
+        start = chrono::steady_clock::now();
+        channel.replay(&reader, 0);
+        readSeconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    }
+
+    cout << "\n" << events << " events of 32 bytes, group commit every 8192 records or 5 ms:" << endl;
+    cout << "  append   | " << uint64_t(events / appendSeconds) << " events/s | " << syncs << " msync batches | "
+         << segmentsUsed << " segments" << endl;
+    cout << "  catch-up | " << uint64_t(reader.records / readSeconds) << " events/s | "
+         << uint64_t(reader.bytes / readSeconds / (1 << 20)) << " MB/s of titles" << endl;
+
+    fs::remove_all(root);
+    return 0;
+}
@@ -0,0 +1,339 @@
+/*
+Indexed Observer (O(1) subscribe / unsubscribe):
+
+In main.cpp, subscribe() loops over every subscriber to reject duplicates and unsubscribe()
+does find() + erase(), so both are O(n). A popular channel with hundreds of thousands of
+subscribers and constant churn spends almost all its time scanning and shifting the vector.
+
+SubscriberRegistry keeps the vector dense for notify() but indexes it:
+
+- dense       : vector<ISubscriber*> iterated by notify(), no holes.
+- slots       : slot map. A SubscriptionToken {index, generation} names a slot, the slot
+                knows where its subscriber currently lives in `dense`.
+- lookup      : hash map ISubscriber* -> slot, for O(1) duplicate detection and for
+                unsubscribe(ISubscriber*).
+- unsubscribe : swap the last dense element into the hole and pop (swap-remove), then bump
+                the slot generation so stale tokens are rejected.
+
+Note: swap-remove means notify() order is not subscription order.
+
+    token {index, gen} ──> slots[index] ──denseIndex──> dense[i] = ISubscriber*
+                                 ^                          │
+                                 └─────── denseToSlot[i] ───┘
+
+main() runs the usual demo and then measures churn throughput (unsubscribe + subscribe)
+against main.cpp's vector implementation at 1k / 100k / 1M subscribers.
+
+Build: g++ -std=c++17 -O2 IndexedChannel.cpp -o IndexedChannel
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Forward declaration
+class ISubscriber;
+
+// Handle returned by subscribe(). Stays valid until that subscription is removed.
+struct SubscriptionToken {
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool valid() const { return index != UINT32_MAX; }
+};
+
+// Subject Interface
+class IChannel {
+public:
+    virtual SubscriptionToken subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(SubscriptionToken token) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update() = 0;
+    virtual ~ISubscriber() {}
+};
+
+// Slot map of subscribers with dense storage for iteration.
+class SubscriberRegistry {
+private:
+    struct Slot {
+        uint32_t denseIndex;
+        uint32_t generation;
+    };
+
+    vector<ISubscriber*> dense;
+    vector<uint32_t> denseToSlot;
+    vector<Slot> slots;
+    vector<uint32_t> freeSlots;
+    unordered_map<ISubscriber*, uint32_t> lookup;
+
+    void removeSlot(uint32_t slotIndex) {
+        uint32_t hole = slots[slotIndex].denseIndex;
+        uint32_t last = uint32_t(dense.size() - 1);
+
+        lookup.erase(dense[hole]);
+        dense[hole] = dense[last];
+        denseToSlot[hole] = denseToSlot[last];
+        slots[denseToSlot[hole]].denseIndex = hole;
+        dense.pop_back();
+        denseToSlot.pop_back();
+
+        slots[slotIndex].generation++;
+        freeSlots.push_back(slotIndex);
+    }
+
+public:
+    void reserve(size_t n) {
+        dense.reserve(n);
+        denseToSlot.reserve(n);
+        slots.reserve(n);
+        lookup.reserve(n);
+    }
+
+    // Returns an invalid token if the subscriber is already registered.
+    SubscriptionToken insert(ISubscriber* subscriber) {
+        auto inserted = lookup.emplace(subscriber, 0);
+        if (!inserted.second) {
+            return SubscriptionToken();
+        }
+
+        uint32_t slotIndex;
+        if (!freeSlots.empty()) {
+            slotIndex = freeSlots.back();
+            freeSlots.pop_back();
+        } else {
+            slotIndex = uint32_t(slots.size());
+            slots.push_back({0, 0});
+        }
+        inserted.first->second = slotIndex;
+
+        slots[slotIndex].denseIndex = uint32_t(dense.size());
+        dense.push_back(subscriber);
+        denseToSlot.push_back(slotIndex);
+        return {slotIndex, slots[slotIndex].generation};
+    }
+
+    bool erase(SubscriptionToken token) {
+        if (!contains(token)) {
+            return false;
+        }
+        removeSlot(token.index);
+        return true;
+    }
+
+    bool erase(ISubscriber* subscriber) {
+        auto it = lookup.find(subscriber);
+        if (it == lookup.end()) {
+            return false;
+        }
+        removeSlot(it->second);
+        return true;
+    }
+
+    // Removing a subscription bumps its slot generation, so stale tokens never match.
+    bool contains(SubscriptionToken token) const {
+        return token.index < slots.size() && slots[token.index].generation == token.generation;
+    }
+
+    const vector<ISubscriber*>& items() const { return dense; }
+    size_t size() const { return dense.size(); }
+};
+
+// Concrete Subject (Channel)
+class IndexedChannel : public IChannel {
+private:
+    SubscriberRegistry subscribers;
+    string channelName;
+    string latestVideo;
+
+public:
+    IndexedChannel(string name, size_t expectedSubscribers = 0) : channelName(name) {
+        subscribers.reserve(expectedSubscribers);
+    }
+
+    SubscriptionToken subscribe(ISubscriber* subscriber) override {
+        return subscribers.insert(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        subscribers.erase(subscriber);
+    }
+
+    void unsubscribe(SubscriptionToken token) override {
+        subscribers.erase(token);
+    }
+
+    void notify() override {
+        for (ISubscriber* sub : subscribers.items()) {
+            sub->update();
+        }
+    }
+
+    void uploadVideo() {
+        cout << "New video \"" << latestVideo << "\" uploaded to channel: " << channelName << endl;
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+
+    size_t subscriberCount() const {
+        return subscribers.size();
+    }
+};
+
+// main.cpp's Channel storage, without the logging, as the benchmark baseline.
+class VectorChannel {
+private:
+    vector<ISubscriber*> subscribers;
+
+public:
+    // Bulk load without the O(n) duplicate check, so building 1M subscribers stays O(n).
+    template <typename It>
+    VectorChannel(It first, It last) {
+        for (; first != last; ++first) {
+            subscribers.push_back(&*first);
+        }
+    }
+
+    void subscribe(ISubscriber* subscriber) {
+        for (auto sub : subscribers) {
+            if (sub == subscriber) {
+                return;
+            }
+        }
+        subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) {
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+class CountingSubscriber : public ISubscriber {
+public:
+    uint64_t updates = 0;
+
+    void update() override {
+        updates++;
+    }
+};
+
+// Each churn op unsubscribes a random live subscriber and subscribes a random idle one.
+// The channel must already hold pool[0, n). Runs for a fixed time budget so the O(n)
+// baseline stays bounded at 1M subscribers.
+template <typename Channel, typename Subscribe, typename Unsubscribe>
+static double churnOpsPerSecond(size_t n, Subscribe subscribeFn, Unsubscribe unsubscribeFn,
+                                vector<CountingSubscriber>& pool, Channel& channel) {
+    vector<size_t> live(n), idle(pool.size() - n);
+    for (size_t i = 0; i < n; i++) {
+        live[i] = i;
+    }
+    for (size_t i = n; i < pool.size(); i++) {
+        idle[i - n] = i;
+    }
+
+    mt19937_64 rng(42);
+    const auto budget = chrono::milliseconds(300);
+    uint64_t ops = 0;
+    auto start = chrono::steady_clock::now();
+    auto elapsed = chrono::steady_clock::duration::zero();
+    while (elapsed < budget) {
+        for (int k = 0; k < 64; k++) {
+            size_t a = rng() % live.size();
+            size_t b = rng() % idle.size();
+            unsubscribeFn(channel, &pool[live[a]]);
+            subscribeFn(channel, &pool[idle[b]]);
+            swap(live[a], idle[b]);
+            ops++;
+        }
+        elapsed = chrono::steady_clock::now() - start;
+    }
+    return ops / chrono::duration<double>(elapsed).count();
+}
+
+// Main function to test the pattern
+int main() {
+    IndexedChannel* myChannel = new IndexedChannel("Tech Insights");
+
+    Subscriber* sub1 = new Subscriber("Alice");
+    Subscriber* sub2 = new Subscriber("Bob");
+
+    SubscriptionToken aliceToken = myChannel->subscribe(sub1);
+    myChannel->subscribe(sub2);
+    if (!myChannel->subscribe(sub1).valid()) {
+        cout << "Alice is already subscribed" << endl;
+    }
+
+    myChannel->setVideo("Observer Design Pattern Explained");
+    myChannel->uploadVideo();
+
+    myChannel->unsubscribe(aliceToken);
+    myChannel->unsubscribe(aliceToken);   // stale token, ignored
+
+    myChannel->setVideo("Understanding Dependency Injection");
+    myChannel->uploadVideo();
+
+    delete sub1;
+    delete sub2;
+    delete myChannel;
+
+    cout << "\nChurn throughput (unsubscribe + subscribe pairs per second):" << endl;
+    for (size_t n : {size_t(1000), size_t(100000), size_t(1000000)}) {
+        vector<CountingSubscriber> pool(n + n / 10 + 1);
+
+        VectorChannel vectorChannel(pool.begin(), pool.begin() + n);
+        double vectorOps = churnOpsPerSecond(
+            n, [](VectorChannel& c, ISubscriber* s) { c.subscribe(s); },
+            [](VectorChannel& c, ISubscriber* s) { c.unsubscribe(s); }, pool, vectorChannel);
+
+        IndexedChannel indexedChannel("Bench", pool.size());
+        for (size_t i = 0; i < n; i++) {
+            indexedChannel.subscribe(&pool[i]);
+        }
+        double indexedOps = churnOpsPerSecond(
+            n, [](IndexedChannel& c, ISubscriber* s) { c.subscribe(s); },
+            [](IndexedChannel& c, ISubscriber* s) { c.unsubscribe(s); }, pool, indexedChannel);
+
+        indexedChannel.notify();
+        uint64_t notified = 0;
+        for (auto& s : pool) {
+            notified += s.updates;
+        }
+
+        cout << "  " << n << " subscribers | vector " << uint64_t(vectorOps)
+             << " ops/s | indexed " << uint64_t(indexedOps) << " ops/s | speedup "
+             << indexedOps / vectorOps << "x | notified " << notified << endl;
+    }
+
+    return 0;
+}
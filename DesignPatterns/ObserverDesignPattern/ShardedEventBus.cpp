@@ -0,0 +1,553 @@
+/*
+Sharded Event Bus (many channels, shared-nothing shards):
+
+In main.cpp every Channel is an isolated subject. Hosting millions of them behind one
+registry would need a global lock on every subscribe / unsubscribe / notify.
+
+EventBus splits channels across shards instead:
+
+- A channel id is hashed to exactly one shard. That shard owns the channel's subscriber
+  list; no other thread ever touches it, so the shard needs no locks.
+- Each shard runs on its own thread and reads commands (Subscribe / Unsubscribe / Notify)
+  from a bounded lock-free inbox. Any thread, including another shard, talks to a channel
+  by posting a message to the owning shard's inbox.
+- BusChannel implements the usual IChannel interface on top of that, so callers keep using
+  subscribe() / unsubscribe() / notify(). These calls are asynchronous: they return once
+  the message is queued. EventBus::flush() waits until everything posted so far has run,
+  including whatever update() posted in turn, so a subscriber can be deleted after it.
+- ISubscriber::update() runs on the owning shard's thread. A subscriber listening to
+  channels on different shards can be called from several threads.
+- update() may post to any channel. Those posts never block a shard forever: messages for
+  its own shard, and anything it drains while waiting on another shard's full inbox, go to
+  an unbounded per-shard overflow list that runs right after the current message. Two shards
+  posting to each other's full inboxes therefore keep making room instead of deadlocking;
+  the cost is that a feedback loop between shards grows the overflow list rather than
+  pushing back.
+
+   producers                 shard 0 inbox ──> shard 0 thread ──> channels {0, 4, 8, ...}
+  (any thread) ── post ──>   shard 1 inbox ──> shard 1 thread ──> channels {1, 5, 9, ...}
+                             shard N inbox ──> shard N thread ──> ...
+
+main() runs the usual demo and then measures notify throughput over 1M channels as the
+number of shards grows from 1 to N.
+
+Build: g++ -std=c++17 -O2 -pthread ShardedEventBus.cpp -o ShardedEventBus
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+using namespace std;
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update() = 0;
+    virtual ~ISubscriber() {}
+};
+
+// Bounded lock-free multi-producer queue with a single consumer (the shard thread).
+// Every cell carries a sequence number telling producers and the consumer whose turn it is.
+template <typename T>
+class ShardInbox {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    vector<Cell> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos{0};
+    alignas(64) size_t dequeuePos = 0;   // consumer only
+
+public:
+    explicit ShardInbox(size_t capacity) : cells(capacity), mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            size_t seq = cell.sequence.load(memory_order_acquire);
+            intptr_t diff = intptr_t(seq) - intptr_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        Cell& cell = cells[dequeuePos & mask];
+        if (cell.sequence.load(memory_order_acquire) != dequeuePos + 1) {
+            return false;
+        }
+        value = cell.data;
+        cell.sequence.store(dequeuePos + mask + 1, memory_order_release);
+        dequeuePos++;
+        return true;
+    }
+
+    size_t pushed() const {
+        return enqueuePos.load(memory_order_acquire);
+    }
+};
+
+class EventBus {
+private:
+    enum class Op : uint8_t { Subscribe, Unsubscribe, Notify };
+
+    struct Message {
+        Op op;
+        uint64_t channelId;
+        ISubscriber* subscriber;
+    };
+
+    struct Deferred {
+        Message msg;
+        bool fromInbox;   // counts towards `processed` once the overflow list is empty
+    };
+
+    struct alignas(64) Shard {
+        ShardInbox<Message> inbox;
+        unordered_map<uint64_t, vector<ISubscriber*>> channels;   // owned by the shard thread
+        deque<Deferred> overflow;                                 // owned by the shard thread
+        alignas(64) atomic<size_t> processed{0};
+        thread th;
+
+        explicit Shard(size_t inboxCapacity) : inbox(inboxCapacity) {}
+    };
+
+    vector<unique_ptr<Shard>> shards;
+    atomic<bool> running{true};
+
+    static thread_local Shard* currentShard;
+
+    static void apply(Shard& shard, const Message& msg) {
+        switch (msg.op) {
+        case Op::Subscribe: {
+            auto& subs = shard.channels[msg.channelId];
+            if (find(subs.begin(), subs.end(), msg.subscriber) == subs.end()) {
+                subs.push_back(msg.subscriber);
+            }
+            break;
+        }
+        case Op::Unsubscribe: {
+            auto it = shard.channels.find(msg.channelId);
+            if (it != shard.channels.end()) {
+                auto& subs = it->second;
+                auto pos = find(subs.begin(), subs.end(), msg.subscriber);
+                if (pos != subs.end()) {
+                    subs.erase(pos);
+                }
+                if (subs.empty()) {
+                    shard.channels.erase(it);
+                }
+            }
+            break;
+        }
+        case Op::Notify: {
+            auto it = shard.channels.find(msg.channelId);
+            if (it != shard.channels.end()) {
+                for (ISubscriber* sub : it->second) {
+                    sub->update();
+                }
+            }
+            break;
+        }
+        }
+    }
+
+    // Applies one inbox message, then whatever update() calls queued on the overflow list.
+    // The inbox messages are only counted once the list is empty, so `processed` never
+    // covers a message whose self-posts are still pending.
+    static void process(Shard& shard, const Message& msg) {
+        apply(shard, msg);
+        size_t done = 1;
+        while (!shard.overflow.empty()) {
+            Deferred d = shard.overflow.front();
+            shard.overflow.pop_front();
+            apply(shard, d.msg);
+            if (d.fromInbox) {
+                done++;
+            }
+        }
+        shard.processed.store(shard.processed.load(memory_order_relaxed) + done, memory_order_release);
+    }
+
+    void run(Shard* shard) {
+        currentShard = shard;
+        int idlePolls = 0;
+        Message msg;
+        while (true) {
+            if (shard->inbox.tryPop(msg)) {
+                process(*shard, msg);
+                idlePolls = 0;
+            } else if (!running.load(memory_order_acquire)) {
+                break;
+            } else if (++idlePolls > 64) {
+                this_thread::yield();
+            }
+        }
+    }
+
+    void post(Op op, uint64_t channelId, ISubscriber* subscriber) {
+        Shard& shard = *shards[shardOf(channelId)];
+        Message msg{op, channelId, subscriber};
+        // Posted from update() on the owning shard: run it after the current message, not
+        // inline (that would modify the subscriber list being iterated).
+        if (currentShard == &shard) {
+            shard.overflow.push_back({msg, false});
+            return;
+        }
+        while (!shard.inbox.tryPush(msg)) {
+            // A shard thread waiting on another full inbox keeps draining its own, so two
+            // shards posting to each other cannot both stall.
+            Message own;
+            if (currentShard != nullptr && currentShard->inbox.tryPop(own)) {
+                currentShard->overflow.push_back({own, true});
+                continue;
+            }
+            this_thread::yield();
+        }
+    }
+
+public:
+    EventBus(size_t shardCount, size_t inboxCapacity = 1 << 16) {
+        for (size_t i = 0; i < max<size_t>(shardCount, 1); i++) {
+            shards.push_back(make_unique<Shard>(inboxCapacity));
+        }
+        for (auto& s : shards) {
+            Shard* raw = s.get();
+            s->th = thread([this, raw] { run(raw); });
+        }
+    }
+
+    // Drains every inbox before returning.
+    ~EventBus() {
+        flush();
+        running.store(false, memory_order_release);
+        for (auto& s : shards) {
+            s->th.join();
+        }
+    }
+
+    size_t shardCount() const {
+        return shards.size();
+    }
+
+    size_t shardOf(uint64_t channelId) const {
+        // splitmix64 finalizer, so sequential ids spread evenly
+        uint64_t x = channelId + 0x9e3779b97f4a7c15ULL;
+        x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+        x ^= x >> 31;
+        return size_t(x % shards.size());
+    }
+
+    void subscribe(uint64_t channelId, ISubscriber* subscriber) { post(Op::Subscribe, channelId, subscriber); }
+    void unsubscribe(uint64_t channelId, ISubscriber* subscriber) { post(Op::Unsubscribe, channelId, subscriber); }
+    void notify(uint64_t channelId) { post(Op::Notify, channelId, nullptr); }
+
+    // Waits until every message posted before the call has been applied, along with
+    // everything update() posted while applying them, on any shard. Must not be called from
+    // a shard thread.
+    void flush() {
+        vector<size_t> targets(shards.size());
+        bool settled = false;
+        while (!settled) {
+            for (size_t i = 0; i < shards.size(); i++) {
+                targets[i] = shards[i]->inbox.pushed();
+                while (shards[i]->processed.load(memory_order_acquire) < targets[i]) {
+                    this_thread::yield();
+                }
+            }
+            // A shard checked early may have been posted to by one checked later.
+            settled = true;
+            for (size_t i = 0; i < shards.size(); i++) {
+                settled = settled && shards[i]->inbox.pushed() == targets[i];
+            }
+        }
+    }
+};
+
+thread_local EventBus::Shard* EventBus::currentShard = nullptr;
+
+// Concrete Subject (Channel) backed by the bus.
+class BusChannel : public IChannel {
+private:
+    EventBus* bus;
+    uint64_t channelId;
+    string channelName;
+    string latestVideo;
+
+public:
+    BusChannel(EventBus* bus, uint64_t channelId, string name)
+        : bus(bus), channelId(channelId), channelName(name) {}
+
+    void subscribe(ISubscriber* subscriber) override {
+        bus->subscribe(channelId, subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        bus->unsubscribe(channelId, subscriber);
+    }
+
+    void notify() override {
+        bus->notify(channelId);
+    }
+
+    void uploadVideo() {
+        cout << "New video \"" << latestVideo << "\" uploaded to channel: " << channelName << endl;
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+// Benchmark observer. Each one only listens to channels of a single shard.
+class alignas(64) CountingSubscriber : public ISubscriber {
+public:
+    uint64_t updates = 0;
+
+    void update() override {
+        updates++;
+    }
+};
+
+// Ping-pong stress: each update() posts up to `fanOut` notifies to a channel on the other
+// shard. With tiny inboxes both shards end up posting into each other's full inbox.
+class Bouncer : public ISubscriber {
+private:
+    EventBus* bus;
+    uint64_t target;
+    atomic<int64_t>* budget;
+    atomic<uint64_t>* updates;
+
+public:
+    Bouncer(EventBus* bus, uint64_t target, atomic<int64_t>* budget, atomic<uint64_t>* updates)
+        : bus(bus), target(target), budget(budget), updates(updates) {}
+
+    void update() override {
+        updates->fetch_add(1, memory_order_relaxed);
+        for (int k = 0; k < 4; k++) {
+            if (budget->fetch_sub(1, memory_order_relaxed) > 0) {
+                bus->notify(target);
+            }
+        }
+    }
+};
+
+// Posts once to another channel on its own shard, which goes to the overflow list.
+class SelfPoster : public ISubscriber {
+private:
+    EventBus* bus;
+    uint64_t target;
+
+public:
+    SelfPoster(EventBus* bus, uint64_t target) : bus(bus), target(target) {}
+
+    void update() override {
+        bus->notify(target);
+    }
+};
+
+// Yields before counting, so a flush() that returns too early would see the old count.
+class SlowSink : public ISubscriber {
+public:
+    uint64_t updates = 0;
+
+    void update() override {
+        this_thread::yield();
+        updates++;
+    }
+};
+
+static bool pingPongStress() {
+    const int64_t bounces = 200000;
+    atomic<int64_t> budget{bounces};
+    atomic<uint64_t> updates{0};
+    EventBus bus(2, 8);
+
+    uint64_t a = 0, b = 1;
+    while (bus.shardOf(b) == bus.shardOf(a)) {
+        b++;
+    }
+    Bouncer atA(&bus, b, &budget, &updates);
+    Bouncer atB(&bus, a, &budget, &updates);
+    bus.subscribe(a, &atA);
+    bus.subscribe(b, &atB);
+    bus.flush();
+
+    bus.notify(a);
+    bus.notify(b);
+    // Every notify reaches exactly one Bouncer: 2 seeds + every bounce the budget allowed.
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(20);
+    while (updates.load() < uint64_t(bounces) + 2) {
+        if (chrono::steady_clock::now() > deadline) {
+            cout << "ping-pong with 8-slot inboxes: FAILED, stuck at " << updates.load() << " updates" << endl;
+            _Exit(1);   // the shards are deadlocked; ~EventBus would hang
+        }
+        this_thread::yield();
+    }
+    cout << "ping-pong with 8-slot inboxes: " << updates.load() << " updates, no deadlock" << endl;
+
+    // update() posting to its own shard: flush() must wait for that post as well.
+    uint64_t from = b + 1, to;
+    while (bus.shardOf(from) != bus.shardOf(a)) {
+        from++;
+    }
+    to = from + 1;
+    while (bus.shardOf(to) != bus.shardOf(a)) {
+        to++;
+    }
+    SelfPoster poster(&bus, to);
+    SlowSink sink;
+    bus.subscribe(from, &poster);
+    bus.subscribe(to, &sink);
+    bus.flush();
+    const uint64_t rounds = 10000;
+    for (uint64_t i = 0; i < rounds; i++) {
+        bus.notify(from);
+        bus.flush();
+        if (sink.updates != i + 1) {
+            cout << "self-post then flush: FAILED, " << sink.updates << " of " << i + 1 << " delivered" << endl;
+            return false;
+        }
+    }
+    cout << "self-post then flush: " << rounds << " rounds, all delivered before flush() returned" << endl;
+    return true;
+}
+
+static void runThroughput(size_t shardCount, uint64_t channelCount, uint64_t notifies) {
+    EventBus bus(shardCount);
+    const size_t subscribersPerShard = 64;
+    vector<vector<CountingSubscriber>> subscribers(shardCount);
+    for (auto& perShard : subscribers) {
+        perShard = vector<CountingSubscriber>(subscribersPerShard);
+    }
+
+    // Two subscribers per channel, both living on the channel's shard.
+    for (uint64_t id = 0; id < channelCount; id++) {
+        auto& local = subscribers[bus.shardOf(id)];
+        bus.subscribe(id, &local[id % subscribersPerShard]);
+        bus.subscribe(id, &local[(id + 1) % subscribersPerShard]);
+    }
+    bus.flush();
+
+    // One producer per shard, each publishing to random channels.
+    auto start = chrono::steady_clock::now();
+    vector<thread> producers;
+    for (size_t p = 0; p < shardCount; p++) {
+        producers.emplace_back([&, p] {
+            mt19937_64 rng(p + 1);
+            for (uint64_t i = 0; i < notifies / shardCount; i++) {
+                bus.notify(rng() % channelCount);
+            }
+        });
+    }
+    for (auto& th : producers) {
+        th.join();
+    }
+    bus.flush();
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    uint64_t updates = 0;
+    for (auto& perShard : subscribers) {
+        for (auto& s : perShard) {
+            updates += s.updates;
+        }
+    }
+    cout << "  " << shardCount << " shard(s) | " << uint64_t(notifies / seconds) << " notify/s | "
+         << uint64_t(updates / seconds) << " update/s" << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    {
+        EventBus bus(2);
+        BusChannel* myChannel = new BusChannel(&bus, 1, "Tech Insights");
+
+        Subscriber* sub1 = new Subscriber("Alice");
+        Subscriber* sub2 = new Subscriber("Bob");
+
+        myChannel->subscribe(sub1);
+        myChannel->subscribe(sub2);
+
+        myChannel->setVideo("Observer Design Pattern Explained");
+        myChannel->uploadVideo();
+        bus.flush();
+
+        myChannel->unsubscribe(sub1);
+
+        myChannel->setVideo("Understanding Dependency Injection");
+        myChannel->uploadVideo();
+        bus.flush();
+
+        delete sub1;
+        delete sub2;
+        delete myChannel;
+    }
+
+    if (!pingPongStress()) {
+        return 1;
+    }
+
+    const uint64_t channelCount = 1 << 20;
+    const uint64_t notifies = 4000000;
+    size_t maxShards = max(2u, thread::hardware_concurrency());
+    cout << "\nNotify throughput, " << channelCount << " channels, 2 subscribers each:" << endl;
+    for (size_t shards = 1; shards <= maxShards; shards *= 2) {
+        runThroughput(shards, channelCount, notifies);
+    }
+
+    return 0;
+}
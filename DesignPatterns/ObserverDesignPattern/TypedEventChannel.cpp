@@ -0,0 +1,273 @@
+/*
+Typed Event Observer (shared read-only payload):
+
+In main.cpp, update() takes no arguments, so a subscriber only learns that *something*
+changed, and setVideo(string) stores a copy of the title in `latestVideo`.
+
+Here every upload produces one immutable VideoEvent:
+
+- setVideo(string) moves the title into the channel (callers can std::move it in).
+- uploadVideo() builds the VideoEvent once, in a single ref-counted allocation
+  (make_shared), and moves the staged title into it.
+- notify() hands the same `const VideoEvent&` to every subscriber. No per-subscriber copies.
+- A subscriber that wants to keep the event past update() calls event.retain(), which
+  only bumps the reference count.
+- The channel name lives in a shared_ptr<const string> created once per channel, so
+  events can outlive the channel without copying the name.
+
+─────────────   make_shared<VideoEvent> once    ┌──────────────┐
+│   Channel   │ ── const VideoEvent& ─────────> │ Subscriber 1 │
+│  (Subject)  │ ── const VideoEvent& ─────────> │ Subscriber 2 │
+─────────────                                   └──────────────┘
+
+main() runs the usual demo and then counts heap allocations per notify with 10k subscribers:
+a typed API that passes the event by value (one copy per subscriber) versus the shared event.
+
+Build: g++ -std=c++17 -O2 TypedEventChannel.cpp -o TypedEventChannel
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <new>
+#include <string>
+#include <vector>
+using namespace std;
+
+// Counts every global operator new so the benchmark can report allocations per notify.
+// Kept out of line so GCC does not pair the inlined free() with operator new and warn.
+static atomic<uint64_t> allocationCount{0};
+
+__attribute__((noinline)) void* operator new(size_t size) {
+    allocationCount.fetch_add(1, memory_order_relaxed);
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+__attribute__((noinline)) void operator delete(void* p) noexcept {
+    free(p);
+}
+
+__attribute__((noinline)) void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+
+// Event payload, immutable once built.
+class VideoEvent : public enable_shared_from_this<VideoEvent> {
+private:
+    shared_ptr<const string> channelName;
+    string title;
+    uint64_t sequence;
+
+public:
+    VideoEvent(shared_ptr<const string> channelName, string&& title, uint64_t sequence)
+        : channelName(move(channelName)), title(move(title)), sequence(sequence) {}
+
+    const string& getChannelName() const { return *channelName; }
+    const string& getTitle() const { return title; }
+    uint64_t getSequence() const { return sequence; }
+
+    // Keep the event alive after update() returns. Costs one reference count bump.
+    shared_ptr<const VideoEvent> retain() const { return shared_from_this(); }
+};
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify(const VideoEvent& event) = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface
+class ISubscriber {
+public:
+    virtual void update(const VideoEvent& event) = 0;
+    virtual ~ISubscriber() {}
+};
+
+// Concrete Subject (Channel)
+class Channel : public IChannel {
+private:
+    vector<ISubscriber*> subscribers;
+    shared_ptr<const string> channelName;
+    string pendingTitle;
+    shared_ptr<const VideoEvent> latestVideo;
+    uint64_t uploadSeq = 0;
+
+public:
+    Channel(string name) : channelName(make_shared<const string>(move(name))) {}
+
+    void subscribe(ISubscriber* subscriber) override {
+        for (auto sub : subscribers) {
+            if (sub == subscriber) {
+                return;
+            }
+        }
+        subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+
+    void notify(const VideoEvent& event) override {
+        for (auto sub : subscribers) {
+            sub->update(event);
+        }
+    }
+
+    void uploadVideo() {
+        latestVideo = make_shared<const VideoEvent>(channelName, move(pendingTitle), ++uploadSeq);
+        pendingTitle.clear();
+        notify(*latestVideo);
+    }
+
+    void setVideo(string videoTitle) {
+        pendingTitle = move(videoTitle);
+    }
+
+    shared_ptr<const VideoEvent> getLatestVideo() const {
+        return latestVideo;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+    shared_ptr<const VideoEvent> lastSeen;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update(const VideoEvent& event) override {
+        cout << "Subscriber " << subscriberName << " notified: \"" << event.getTitle()
+             << "\" on " << event.getChannelName() << " (#" << event.getSequence() << ")" << endl;
+        lastSeen = event.retain();
+    }
+
+    void printLastSeen() const {
+        if (lastSeen) {
+            cout << subscriberName << " last saw \"" << lastSeen->getTitle() << "\"" << endl;
+        }
+    }
+};
+
+// ---- Benchmark ----
+
+// What a typed API looks like without a shared payload: each subscriber gets its own copy.
+struct VideoEventCopy {
+    string channelName;
+    string title;
+    uint64_t sequence;
+};
+
+class ICopyingSubscriber {
+public:
+    virtual void update(VideoEventCopy event) = 0;
+    virtual ~ICopyingSubscriber() {}
+};
+
+class CopyingSubscriber : public ICopyingSubscriber {
+public:
+    size_t titleBytes = 0;
+
+    void update(VideoEventCopy event) override {
+        titleBytes += event.title.size();
+    }
+};
+
+class SharedSubscriber : public ISubscriber {
+public:
+    size_t titleBytes = 0;
+
+    void update(const VideoEvent& event) override {
+        titleBytes += event.getTitle().size();
+    }
+};
+
+// Main function to test the pattern
+int main() {
+    Channel* myChannel = new Channel("Tech Insights");
+
+    Subscriber* sub1 = new Subscriber("Alice");
+    Subscriber* sub2 = new Subscriber("Bob");
+
+    myChannel->subscribe(sub1);
+    myChannel->subscribe(sub2);
+
+    myChannel->setVideo("Observer Design Pattern Explained");
+    myChannel->uploadVideo();
+
+    myChannel->unsubscribe(sub1);
+
+    myChannel->setVideo("Understanding Dependency Injection");
+    myChannel->uploadVideo();
+
+    // Alice still holds the first event even though the channel moved on.
+    sub1->printLastSeen();
+    sub2->printLastSeen();
+
+    delete sub1;
+    delete sub2;
+    delete myChannel;
+
+    const int subscriberCount = 10000;
+    const int uploads = 100;
+    const string channelName = "Tech Insights Weekly Deep Dives";
+    const string title = "Observer Design Pattern Explained In Depth, Part 1";
+
+    // Before: the event is copied into every update() call.
+    vector<CopyingSubscriber> copying(subscriberCount);
+    vector<ICopyingSubscriber*> copyingList;
+    for (auto& s : copying) {
+        copyingList.push_back(&s);
+    }
+    uint64_t before = allocationCount.load();
+    auto t0 = chrono::steady_clock::now();
+    for (int u = 0; u < uploads; u++) {
+        VideoEventCopy event{channelName, title, uint64_t(u)};
+        for (auto sub : copyingList) {
+            sub->update(event);
+        }
+    }
+    auto t1 = chrono::steady_clock::now();
+    double copyAllocs = double(allocationCount.load() - before) / uploads;
+    double copyUs = chrono::duration<double, micro>(t1 - t0).count() / uploads;
+
+    // After: one shared event per upload.
+    Channel channel(channelName);
+    vector<SharedSubscriber> shared(subscriberCount);
+    for (auto& s : shared) {
+        channel.subscribe(&s);
+    }
+    vector<string> titles(uploads, title);   // staged up front, like a caller moving its string in
+    before = allocationCount.load();
+    t0 = chrono::steady_clock::now();
+    for (int u = 0; u < uploads; u++) {
+        channel.setVideo(move(titles[u]));
+        channel.uploadVideo();
+    }
+    t1 = chrono::steady_clock::now();
+    double sharedAllocs = double(allocationCount.load() - before) / uploads;
+    double sharedUs = chrono::duration<double, micro>(t1 - t0).count() / uploads;
+
+    cout << "\nAllocations per notify, " << subscriberCount << " subscribers:" << endl;
+    cout << "  event copied per subscriber | " << copyAllocs << " allocations | " << copyUs << " us" << endl;
+    cout << "  shared VideoEvent           | " << sharedAllocs << " allocations | " << sharedUs << " us" << endl;
+
+    return 0;
+}
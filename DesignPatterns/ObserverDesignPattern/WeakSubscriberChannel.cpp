@@ -0,0 +1,351 @@
+/*
+Weak-Handle Observer (no dangling subscribers):
+
+In main.cpp, Channel stores raw ISubscriber* pointers. If a subscriber is deleted without
+calling unsubscribe(), the next notify() calls update() on freed memory.
+
+Here every ISubscriber owns a generation-counted lifetime slot:
+
+- Constructing an ISubscriber takes a slot from a global table and remembers the slot's
+  current generation. Destroying it bumps the generation and returns the slot.
+- Slots live in fixed-size chunks that are never freed, so a slot address stays valid
+  forever even after its subscriber is gone.
+- A slot holds the generation and the subscriber pointer. Channel stores a SubscriberHandle
+  {slot, generation}: equal generations mean the subscriber is alive, different means it was
+  destroyed.
+- The registry also counts deaths (any subscriber destroyed, anywhere). notify() loads that
+  counter once per pass. If it has not moved since the channel last looked, every handle is
+  still alive, and delivery walks a packed ISubscriber* array exactly like main.cpp. Only when
+  it has moved does a separate compaction pass check each handle's generation and drop the
+  expired ones before delivering.
+- So the steady-state cost is one atomic load per notify(), not per subscriber: no lock, no
+  shared_ptr, no reference count. A program that destroys subscribers between most
+  notify() calls pays one O(n) compaction per notify().
+
+    notify(): deaths == seenDeaths ──> for sub in live[]: sub->update()        (raw speed)
+              deaths moved          ──> compact: handle {slot*, gen 7} vs slot gen 8 -> drop
+                                        then deliver as above
+
+Thread rules are the same as main.cpp: a subscriber must not be destroyed while a notify()
+that includes it is running on another thread. The slot table itself is thread-safe.
+
+main() runs the usual demo (deleting a subscriber without unsubscribing) and then compares
+notify() cost against raw pointers.
+
+Build: g++ -std=c++17 -O2 -pthread WeakSubscriberChannel.cpp -o WeakSubscriberChannel
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+using namespace std;
+
+class ISubscriber;
+
+// Generation and object pointer share one slot, so a liveness check and the pointer it
+// guards come from the same cache line.
+struct LifetimeSlot {
+    atomic<uint32_t> generation{0};
+    ISubscriber* subscriber = nullptr;
+};
+
+// Global table of lifetime slots. Only touched when a subscriber is created or destroyed.
+class LifetimeRegistry {
+private:
+    static const size_t ChunkSize = 4096;
+
+    mutex mtx;
+    vector<unique_ptr<LifetimeSlot[]>> chunks;   // never shrinks, so slot addresses are stable
+    vector<LifetimeSlot*> freeSlots;
+    atomic<uint64_t> deaths{0};
+
+public:
+    static LifetimeRegistry& instance() {
+        static LifetimeRegistry registry;
+        return registry;
+    }
+
+    LifetimeSlot* acquire(ISubscriber* subscriber) {
+        lock_guard<mutex> lock(mtx);
+        if (freeSlots.empty()) {
+            chunks.push_back(make_unique<LifetimeSlot[]>(ChunkSize));
+            LifetimeSlot* chunk = chunks.back().get();
+            for (size_t i = ChunkSize; i-- > 0;) {
+                freeSlots.push_back(&chunk[i]);
+            }
+        }
+        LifetimeSlot* slot = freeSlots.back();
+        freeSlots.pop_back();
+        slot->subscriber = subscriber;
+        return slot;
+    }
+
+    void release(LifetimeSlot* slot) {
+        slot->generation.fetch_add(1, memory_order_release);
+        deaths.fetch_add(1, memory_order_release);
+        lock_guard<mutex> lock(mtx);
+        freeSlots.push_back(slot);
+    }
+
+    // Number of subscribers destroyed so far. Unchanged means no handle has expired.
+    uint64_t deathCount() const {
+        return deaths.load(memory_order_acquire);
+    }
+};
+
+// Observer Interface. The base class ties every subscriber to a lifetime slot.
+class ISubscriber {
+private:
+    LifetimeSlot* slot;
+    uint32_t generation;
+
+public:
+    ISubscriber() : slot(LifetimeRegistry::instance().acquire(this)) {
+        generation = slot->generation.load(memory_order_relaxed);
+    }
+
+    // A copy is a different subscriber, so it gets its own slot.
+    ISubscriber(const ISubscriber&) : ISubscriber() {}
+    ISubscriber& operator=(const ISubscriber&) { return *this; }
+
+    virtual ~ISubscriber() {
+        LifetimeRegistry::instance().release(slot);
+    }
+
+    virtual void update() = 0;
+
+    LifetimeSlot* lifetimeSlot() const { return slot; }
+    uint32_t lifetimeGeneration() const { return generation; }
+};
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Weak reference to a subscriber: 16 bytes, no reference count.
+struct SubscriberHandle {
+    LifetimeSlot* slot;
+    uint32_t generation;
+
+    explicit SubscriberHandle(ISubscriber* sub)
+        : slot(sub->lifetimeSlot()), generation(sub->lifetimeGeneration()) {}
+
+    bool alive() const {
+        return slot->generation.load(memory_order_acquire) == generation;
+    }
+
+    // nullptr once the subscriber has been destroyed.
+    ISubscriber* get() const {
+        return alive() ? slot->subscriber : nullptr;
+    }
+
+    bool refersTo(ISubscriber* sub) const {
+        return get() == sub;
+    }
+};
+
+// Concrete Subject (Channel)
+class Channel : public IChannel {
+private:
+    vector<SubscriberHandle> handles;   // liveness, parallel to `live`
+    vector<ISubscriber*> live;          // what notify() walks
+    uint64_t seenDeaths = LifetimeRegistry::instance().deathCount();
+    string channelName;
+    string latestVideo;
+    size_t pruned = 0;
+
+    // Drops every expired handle, keeping subscription order.
+    void compact() {
+        size_t kept = 0;
+        for (size_t i = 0; i < handles.size(); i++) {
+            if (handles[i].alive()) {
+                handles[kept] = handles[i];
+                live[kept] = live[i];
+                kept++;
+            }
+        }
+        pruned += handles.size() - kept;
+        handles.erase(handles.begin() + kept, handles.end());
+        live.resize(kept);
+    }
+
+    // Read the counter before compacting: a death during compact() is caught next time.
+    void compactIfAnyDied() {
+        uint64_t deaths = LifetimeRegistry::instance().deathCount();
+        if (deaths != seenDeaths) {
+            seenDeaths = deaths;
+            compact();
+        }
+    }
+
+public:
+    Channel(string name) : channelName(name) {}
+
+    // A dead handle that happens to hold the same address as `subscriber` does not count as
+    // a duplicate, so expired handles are dropped first.
+    void subscribe(ISubscriber* subscriber) override {
+        compactIfAnyDied();
+        if (find(live.begin(), live.end(), subscriber) != live.end()) {
+            return;
+        }
+        handles.emplace_back(subscriber);
+        live.push_back(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        compactIfAnyDied();
+        auto it = find(live.begin(), live.end(), subscriber);
+        if (it != live.end()) {
+            handles.erase(handles.begin() + (it - live.begin()));
+            live.erase(it);
+        }
+    }
+
+    // update() must not subscribe or unsubscribe on this same channel.
+    void notify() override {
+        compactIfAnyDied();
+        for (ISubscriber* sub : live) {
+            sub->update();
+        }
+    }
+
+    void uploadVideo() {
+        cout << "New video \"" << latestVideo << "\" uploaded to channel: " << channelName << endl;
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+
+    size_t prunedCount() const {
+        return pruned;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+// ---- Benchmark ----
+
+class CountingSubscriber : public ISubscriber {
+public:
+    uint64_t updates = 0;
+
+    void update() override {
+        updates++;
+    }
+};
+
+// A subscriber doing a little real work per update (a few dozen ns).
+class WorkingSubscriber : public ISubscriber {
+public:
+    uint64_t state = 1;
+
+    void update() override {
+        for (int i = 0; i < 16; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+};
+
+// main.cpp's storage: raw pointers, no liveness check.
+class RawChannel {
+private:
+    vector<ISubscriber*> subscribers;
+
+public:
+    void subscribe(ISubscriber* subscriber) { subscribers.push_back(subscriber); }
+
+    void notify() {
+        for (auto sub : subscribers) {
+            sub->update();
+        }
+    }
+};
+
+template <typename Channel>
+static double nsPerUpdate(Channel& channel, size_t subscriberCount, int rounds) {
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        channel.notify();
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    return ns / (double(subscriberCount) * rounds);
+}
+
+template <typename Sub>
+static void compareOverhead(const string& label) {
+    const size_t subscriberCount = 20000;
+    const int rounds = 2000;
+    vector<Sub> subs(subscriberCount);
+
+    RawChannel raw;
+    Channel weak("Bench");
+    for (auto& s : subs) {
+        raw.subscribe(&s);
+        weak.subscribe(&s);
+    }
+
+    // Warm up, then alternate runs to even out frequency scaling.
+    nsPerUpdate(raw, subscriberCount, 20);
+    nsPerUpdate(weak, subscriberCount, 20);
+    double rawNs = 0, weakNs = 0;
+    for (int i = 0; i < 5; i++) {
+        rawNs += nsPerUpdate(raw, subscriberCount, rounds / 5);
+        weakNs += nsPerUpdate(weak, subscriberCount, rounds / 5);
+    }
+    cout << "  " << label << " | raw " << rawNs / 5 << " ns | weak " << weakNs / 5
+         << " ns per update | overhead " << (weakNs / rawNs - 1.0) * 100.0 << "%" << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    Channel* myChannel = new Channel("Tech Insights");
+
+    Subscriber* sub1 = new Subscriber("Alice");
+    Subscriber* sub2 = new Subscriber("Bob");
+
+    myChannel->subscribe(sub1);
+    myChannel->subscribe(sub2);
+
+    myChannel->setVideo("Observer Design Pattern Explained");
+    myChannel->uploadVideo();
+
+    // Alice goes away without unsubscribing. With raw pointers the next upload is a use-after-free.
+    delete sub1;
+
+    myChannel->setVideo("Understanding Dependency Injection");
+    myChannel->uploadVideo();
+    cout << "Expired subscribers pruned: " << myChannel->prunedCount() << endl;
+
+    delete sub2;
+    delete myChannel;
+
+    cout << "\nnotify() cost, 20000 subscribers:" << endl;
+    compareOverhead<CountingSubscriber>("empty update()  ");
+    compareOverhead<WorkingSubscriber>("working update()");
+
+    return 0;
+}
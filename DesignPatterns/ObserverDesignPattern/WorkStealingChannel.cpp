@@ -0,0 +1,524 @@
+/*
+Parallel Observer (lock-free MPMC queue + work-stealing pool):
+
+main.cpp delivers update() calls one after another on the publishing thread, and the only
+synchronization primitive in the codebase is the std::mutex in the singleton demo.
+This file adds the two building blocks needed to spread delivery across cores:
+
+- MpmcQueue<T>: bounded lock-free multi-producer / multi-consumer ring. Every cell carries
+  a sequence number that says whether it is ready to be written or read, so producers and
+  consumers each claim a position with one CAS.
+- WorkStealingPool: one thread per core. Each worker owns a Chase-Lev deque (the owner pushes
+  and pops at the bottom, idle workers steal from the top). Work from outside the pool enters
+  through a shared MpmcQueue.
+
+ParallelChannel::notify() cuts the subscriber list into a few large ranges and submits them.
+A worker that takes a range keeps splitting it in half, pushing one half onto its own deque,
+until the range is small (`grain`). Idle workers steal those halves, so uneven update() costs
+balance out. notify() returns when every update() has run; the calling thread helps run
+tasks while it waits, which also makes a notify() from inside update() safe.
+
+   notify() ── ranges ──> MpmcQueue ──> worker 0 [deque] <── steal ── worker 1 [deque] ...
+                                             │ split / run
+                                             └──> update() on subscribers [begin, end)
+
+main() runs the usual demo, then microbenchmarks queue throughput from 1 to 32 threads and
+notify() throughput with 1 to N workers.
+
+Build: g++ -std=c++17 -O2 -pthread WorkStealingChannel.cpp -o WorkStealingChannel
+*/
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Forward declaration
+class ISubscriber;
+
+// Subject Interface
+class IChannel {
+public:
+    virtual void subscribe(ISubscriber* subscriber) = 0;
+    virtual void unsubscribe(ISubscriber* subscriber) = 0;
+    virtual void notify() = 0;
+    virtual ~IChannel() {}
+};
+
+// Observer Interface. With ParallelChannel, update() may run on any worker thread.
+class ISubscriber {
+public:
+    virtual void update() = 0;
+    virtual ~ISubscriber() {}
+};
+
+// Bounded lock-free MPMC queue (capacity rounded up to a power of two).
+template <typename T>
+class MpmcQueue {
+private:
+    struct Cell {
+        atomic<size_t> sequence;
+        T data;
+    };
+
+    vector<Cell> cells;
+    size_t mask;
+    alignas(64) atomic<size_t> enqueuePos{0};
+    alignas(64) atomic<size_t> dequeuePos{0};
+
+    static size_t roundUp(size_t n) {
+        size_t p = 2;
+        while (p < n) {
+            p <<= 1;
+        }
+        return p;
+    }
+
+public:
+    explicit MpmcQueue(size_t capacity) : cells(roundUp(capacity)), mask(cells.size() - 1) {
+        for (size_t i = 0; i < cells.size(); i++) {
+            cells[i].sequence.store(i, memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(const T& value) {
+        size_t pos = enqueuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            intptr_t diff = intptr_t(cell.sequence.load(memory_order_acquire)) - intptr_t(pos);
+            if (diff == 0) {
+                if (enqueuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    cell.data = value;
+                    cell.sequence.store(pos + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // full
+            } else {
+                pos = enqueuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& value) {
+        size_t pos = dequeuePos.load(memory_order_relaxed);
+        while (true) {
+            Cell& cell = cells[pos & mask];
+            intptr_t diff = intptr_t(cell.sequence.load(memory_order_acquire)) - intptr_t(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos.compare_exchange_weak(pos, pos + 1, memory_order_relaxed)) {
+                    value = cell.data;
+                    cell.sequence.store(pos + mask + 1, memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;   // empty
+            } else {
+                pos = dequeuePos.load(memory_order_relaxed);
+            }
+        }
+    }
+};
+
+// A unit of work: run `job` over items [begin, end).
+struct Job;
+
+struct Task {
+    Job* job = nullptr;
+    uint32_t begin = 0;
+    uint32_t end = 0;
+};
+
+struct Job {
+    ISubscriber* const* subscribers;
+    atomic<size_t> remaining;   // subscribers not yet updated
+};
+
+// Fixed-capacity Chase-Lev work-stealing deque.
+// Slots are atomics so a thief's read racing with the owner's write is well defined;
+// such a read is always thrown away because the thief's CAS on `top` fails.
+class WorkStealingDeque {
+private:
+    struct Slot {
+        atomic<Job*> job{nullptr};
+        atomic<uint64_t> range{0};
+    };
+
+    vector<Slot> slots;
+    int64_t mask;
+    alignas(64) atomic<int64_t> top{0};
+    alignas(64) atomic<int64_t> bottom{0};
+
+    Task load(int64_t i) const {
+        const Slot& s = slots[i & mask];
+        uint64_t r = s.range.load(memory_order_relaxed);
+        return {s.job.load(memory_order_relaxed), uint32_t(r >> 32), uint32_t(r)};
+    }
+
+public:
+    explicit WorkStealingDeque(size_t capacity) : slots(capacity), mask(int64_t(capacity) - 1) {}
+
+    // Owner only.
+    bool push(const Task& task) {
+        int64_t b = bottom.load(memory_order_relaxed);
+        int64_t t = top.load(memory_order_acquire);
+        if (b - t > mask) {
+            return false;
+        }
+        Slot& s = slots[b & mask];
+        s.job.store(task.job, memory_order_relaxed);
+        s.range.store((uint64_t(task.begin) << 32) | task.end, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        bottom.store(b + 1, memory_order_relaxed);
+        return true;
+    }
+
+    // Owner only.
+    bool pop(Task& task) {
+        int64_t b = bottom.load(memory_order_relaxed) - 1;
+        bottom.store(b, memory_order_relaxed);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t t = top.load(memory_order_relaxed);
+        if (t > b) {
+            bottom.store(b + 1, memory_order_relaxed);
+            return false;
+        }
+        task = load(b);
+        if (t == b) {
+            // Last element: race the thieves for it.
+            bool won = top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+            bottom.store(b + 1, memory_order_relaxed);
+            return won;
+        }
+        return true;
+    }
+
+    // Any thread.
+    bool steal(Task& task) {
+        int64_t t = top.load(memory_order_acquire);
+        atomic_thread_fence(memory_order_seq_cst);
+        int64_t b = bottom.load(memory_order_acquire);
+        if (t >= b) {
+            return false;
+        }
+        task = load(t);
+        return top.compare_exchange_strong(t, t + 1, memory_order_seq_cst, memory_order_relaxed);
+    }
+};
+
+class WorkStealingPool {
+private:
+    struct alignas(64) Worker {
+        WorkStealingDeque deque{1024};
+        thread th;
+    };
+
+    vector<unique_ptr<Worker>> workers;
+    MpmcQueue<Task> injection{4096};
+    atomic<bool> running{true};
+    uint32_t grain;
+
+    mutex sleepMtx;
+    condition_variable sleepCv;
+    atomic<int> sleepers{0};
+
+    static thread_local Worker* self;
+    static thread_local WorkStealingPool* selfPool;
+
+    // Splits big ranges onto our own deque (when we have one) and runs the rest.
+    void run(Task task) {
+        Worker* me = (selfPool == this) ? self : nullptr;
+        while (me && task.end - task.begin > grain) {
+            uint32_t mid = task.begin + (task.end - task.begin) / 2;
+            if (!me->deque.push({task.job, mid, task.end})) {
+                break;
+            }
+            task.end = mid;
+        }
+        for (uint32_t i = task.begin; i < task.end; i++) {
+            task.job->subscribers[i]->update();
+        }
+        task.job->remaining.fetch_sub(task.end - task.begin, memory_order_acq_rel);
+    }
+
+    bool findTask(Task& task, size_t start) {
+        if (selfPool == this && self->deque.pop(task)) {
+            return true;
+        }
+        if (injection.tryPop(task)) {
+            return true;
+        }
+        for (size_t i = 0; i < workers.size(); i++) {
+            Worker* victim = workers[(start + i) % workers.size()].get();
+            if (victim != self && victim->deque.steal(task)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(Worker* me, size_t index) {
+        self = me;
+        selfPool = this;
+        int idle = 0;
+        Task task;
+        while (running.load(memory_order_acquire)) {
+            if (findTask(task, index + idle)) {
+                run(task);
+                idle = 0;
+            } else if (++idle < 64) {
+                this_thread::yield();
+            } else {
+                unique_lock<mutex> lock(sleepMtx);
+                sleepers.fetch_add(1);
+                sleepCv.wait_for(lock, chrono::milliseconds(1));
+                sleepers.fetch_sub(1);
+                idle = 0;
+            }
+        }
+    }
+
+public:
+    WorkStealingPool(size_t workerCount, uint32_t grain = 256) : grain(grain) {
+        for (size_t i = 0; i < max<size_t>(workerCount, 1); i++) {
+            workers.push_back(make_unique<Worker>());
+        }
+        for (size_t i = 0; i < workers.size(); i++) {
+            Worker* w = workers[i].get();
+            w->th = thread([this, w, i] { workerLoop(w, i); });
+        }
+    }
+
+    ~WorkStealingPool() {
+        running.store(false, memory_order_release);
+        sleepCv.notify_all();
+        for (auto& w : workers) {
+            w->th.join();
+        }
+    }
+
+    size_t size() const {
+        return workers.size();
+    }
+
+    // Runs update() on every subscriber in `subscribers` and returns when all are done.
+    void forEach(ISubscriber* const* subscribers, size_t count) {
+        if (count == 0) {
+            return;
+        }
+        Job job{subscribers, {count}};
+        size_t chunks = min(count, workers.size() * 4);
+        for (size_t c = 0; c < chunks; c++) {
+            Task task{&job, uint32_t(count * c / chunks), uint32_t(count * (c + 1) / chunks)};
+            if (!injection.tryPush(task)) {
+                run(task);   // queue full: do it ourselves
+            }
+        }
+        if (sleepers.load(memory_order_relaxed) > 0) {
+            sleepCv.notify_all();
+        }
+
+        // Help instead of blocking, so waiting never starves the pool.
+        Task task;
+        while (job.remaining.load(memory_order_acquire) > 0) {
+            if (findTask(task, 0)) {
+                run(task);
+            } else {
+                this_thread::yield();
+            }
+        }
+    }
+};
+
+thread_local WorkStealingPool::Worker* WorkStealingPool::self = nullptr;
+thread_local WorkStealingPool* WorkStealingPool::selfPool = nullptr;
+
+// Concrete Subject (Channel)
+class ParallelChannel : public IChannel {
+private:
+    vector<ISubscriber*> subscribers;
+    string channelName;
+    string latestVideo;
+    WorkStealingPool* pool;
+
+public:
+    ParallelChannel(string name, WorkStealingPool* pool) : channelName(name), pool(pool) {}
+
+    void subscribe(ISubscriber* subscriber) override {
+        for (auto sub : subscribers) {
+            if (sub == subscriber) {
+                return;
+            }
+        }
+        subscribers.push_back(subscriber);
+    }
+
+    void unsubscribe(ISubscriber* subscriber) override {
+        auto it = find(subscribers.begin(), subscribers.end(), subscriber);
+        if (it != subscribers.end()) {
+            subscribers.erase(it);
+        }
+    }
+
+    // Must not run concurrently with subscribe()/unsubscribe() on this channel.
+    void notify() override {
+        pool->forEach(subscribers.data(), subscribers.size());
+    }
+
+    void uploadVideo() {
+        cout << "New video \"" << latestVideo << "\" uploaded to channel: " << channelName << endl;
+        notify();
+    }
+
+    void setVideo(string videoTitle) {
+        latestVideo = videoTitle;
+    }
+};
+
+// Concrete Observer (Subscriber)
+class Subscriber : public ISubscriber {
+private:
+    string subscriberName;
+    static mutex coutMtx;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() override {
+        lock_guard<mutex> lock(coutMtx);
+        cout << "Subscriber " << subscriberName << " has been notified of new content!" << endl;
+    }
+};
+
+mutex Subscriber::coutMtx;
+
+// ---- Benchmarks ----
+
+class alignas(64) WorkingSubscriber : public ISubscriber {
+public:
+    uint64_t state = 1;
+
+    void update() override {
+        for (int i = 0; i < 64; i++) {
+            state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+        }
+    }
+};
+
+// Half of the threads push, half pop (a single thread alternates).
+static void queueThroughput(int threads) {
+    const uint64_t totalOps = 2000000;
+    MpmcQueue<uint64_t> queue(1024);
+    atomic<bool> go{false};
+    vector<thread> pool;
+
+    auto start = chrono::steady_clock::now();
+    if (threads == 1) {
+        uint64_t v;
+        for (uint64_t i = 0; i < totalOps; i++) {
+            queue.tryPush(i);
+            queue.tryPop(v);
+        }
+    } else {
+        int producers = threads / 2, consumers = threads - producers;
+        uint64_t perProducer = totalOps / producers;
+        uint64_t perConsumer = perProducer * producers / consumers;
+        uint64_t extra = perProducer * producers - perConsumer * consumers;
+        for (int p = 0; p < producers; p++) {
+            pool.emplace_back([&] {
+                while (!go.load()) {
+                    this_thread::yield();
+                }
+                for (uint64_t i = 0; i < perProducer; i++) {
+                    while (!queue.tryPush(i)) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        for (int c = 0; c < consumers; c++) {
+            pool.emplace_back([&, c] {
+                while (!go.load()) {
+                    this_thread::yield();
+                }
+                uint64_t v, n = perConsumer + (c == 0 ? extra : 0);
+                for (uint64_t i = 0; i < n; i++) {
+                    while (!queue.tryPop(v)) {
+                        this_thread::yield();
+                    }
+                }
+            });
+        }
+        start = chrono::steady_clock::now();
+        go.store(true);
+        for (auto& th : pool) {
+            th.join();
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << threads << " thread(s) | " << uint64_t(totalOps / seconds) << " push+pop pairs/s" << endl;
+}
+
+static void notifyThroughput(size_t workers) {
+    const size_t subscriberCount = 100000;
+    const int rounds = 50;
+    vector<WorkingSubscriber> subs(subscriberCount);
+    WorkStealingPool pool(workers);
+    ParallelChannel channel("Bench", &pool);
+    for (auto& s : subs) {
+        channel.subscribe(&s);
+    }
+    auto start = chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+        channel.notify();
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << "  " << workers << " worker(s) | " << uint64_t(rounds * subscriberCount / seconds) << " updates/s" << endl;
+}
+
+// Main function to test the pattern
+int main() {
+    {
+        WorkStealingPool pool(2);
+        ParallelChannel* myChannel = new ParallelChannel("Tech Insights", &pool);
+
+        Subscriber* sub1 = new Subscriber("Alice");
+        Subscriber* sub2 = new Subscriber("Bob");
+
+        myChannel->subscribe(sub1);
+        myChannel->subscribe(sub2);
+
+        myChannel->setVideo("Observer Design Pattern Explained");
+        myChannel->uploadVideo();
+
+        myChannel->unsubscribe(sub1);
+
+        myChannel->setVideo("Understanding Dependency Injection");
+        myChannel->uploadVideo();
+
+        delete sub1;
+        delete sub2;
+        delete myChannel;
+    }
+
+    cout << "\nMpmcQueue throughput (capacity 1024):" << endl;
+    for (int threads = 1; threads <= 32; threads *= 2) {
+        queueThroughput(threads);
+    }
+
+    cout << "\nParallel notify, 100000 subscribers:" << endl;
+    size_t maxWorkers = max(2u, thread::hardware_concurrency());
+    for (size_t workers = 1; workers <= maxWorkers; workers *= 2) {
+        notifyThroughput(workers);
+    }
+
+    return 0;
+}
@@ -27,6 +27,9 @@
  * - Note: Double-checked locking requires C++11 or later, because of memory
  *   model improvements and guarantees for static/local variables and atomics.
  *   In pre-C++11, this pattern can have subtle bugs!
+ * - Even in C++11, the first check below reads a plain pointer that another thread
+ *   may be writing, which is a data race. See 5_AtomicDoubleCheckedLocking.cpp for
+ *   the version that uses std::atomic with acquire/release ordering.
  *
  * -----------------
  * **Key Points:**
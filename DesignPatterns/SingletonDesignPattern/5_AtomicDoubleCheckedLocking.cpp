@@ -0,0 +1,174 @@
+/*
+ * This program demonstrates a **correct, lock-free fast path** for the
+ * Double-Checked Locking Singleton using `std::atomic` with acquire/release ordering.
+ *
+ * -----------------
+ * **What is wrong with 3_ThreadSafeDoubleLocking.cpp:**
+ * - The first check reads the plain `static Singleton* instance` without holding the lock,
+ *   while another thread may be writing it under the lock. That is a data race, which is
+ *   undefined behavior in the C++ memory model.
+ * - In practice the compiler or a weakly ordered CPU (ARM, POWER) may make the pointer
+ *   visible before the constructor's writes. A second thread can then see a non-null
+ *   `instance` and use a partially constructed object.
+ *
+ * -----------------
+ * **How the atomic version fixes it:**
+ * - `instance` becomes `std::atomic<Singleton*>`.
+ * - Fast path: `instance.load(memory_order_acquire)`. If it is non-null, every write made
+ *   by the constructor is guaranteed to be visible to this thread.
+ * - Slow path: take the mutex, re-check with a relaxed load (the mutex already orders it),
+ *   construct, then `instance.store(p, memory_order_release)` to publish the finished object.
+ * - On x86 an acquire load is a plain `mov`, so the fast path costs the same as the racy one.
+ *
+ * -----------------
+ * **Alternatives compared in main():**
+ * - Meyers singleton: a function-local `static`. C++11 guarantees thread-safe
+ *   initialization; the compiler emits an acquire-load guard check much like ours.
+ * - `std::call_once` with a `std::once_flag`: correct, but every call goes through the
+ *   once_flag check, which is usually a bit slower.
+ * - The original (racy) double-checked locking from 3_ThreadSafeDoubleLocking.cpp.
+ *
+ * main() starts 64 threads that all hammer getInstance() and reports the cost per call
+ * for each version.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread 5_AtomicDoubleCheckedLocking.cpp
+ */
+
+#include<atomic>
+#include<chrono>
+#include<iostream>
+#include<mutex>
+#include<string>
+#include<thread>
+#include<vector>
+using namespace std;
+
+class Singleton {
+private:
+    static atomic<Singleton*> instance;
+    static mutex mtx;
+
+    // Private constructor prevents direct instantiation.
+    Singleton() {
+        cout << "Singleton Constructor Called!" << endl;
+    }
+
+public:
+    // Lock-free after the first call: one acquire load.
+    static Singleton* getInstance() {
+        Singleton* p = instance.load(memory_order_acquire);   // First check (without locking)
+        if (p == nullptr) {
+            lock_guard<mutex> lock(mtx);                      // Lock only when necessary
+            p = instance.load(memory_order_relaxed);          // Second check (with lock)
+            if (p == nullptr) {
+                p = new Singleton();
+                instance.store(p, memory_order_release);      // Publish the finished object
+            }
+        }
+        return p;
+    }
+};
+
+// Initialize static members
+atomic<Singleton*> Singleton::instance{nullptr};
+mutex Singleton::mtx;
+
+// ---- Versions used only by the benchmark ----
+
+// 3_ThreadSafeDoubleLocking.cpp as written (racy first check).
+class LegacyDclSingleton {
+private:
+    static LegacyDclSingleton* instance;
+    static mutex mtx;
+
+    LegacyDclSingleton() {}
+
+public:
+    static LegacyDclSingleton* getInstance() {
+        if (instance == nullptr) {
+            lock_guard<mutex> lock(mtx);
+            if (instance == nullptr) {
+                instance = new LegacyDclSingleton();
+            }
+        }
+        return instance;
+    }
+};
+
+LegacyDclSingleton* LegacyDclSingleton::instance = nullptr;
+mutex LegacyDclSingleton::mtx;
+
+class MeyersSingleton {
+private:
+    MeyersSingleton() {}
+
+public:
+    static MeyersSingleton* getInstance() {
+        static MeyersSingleton instance;
+        return &instance;
+    }
+};
+
+class CallOnceSingleton {
+private:
+    static CallOnceSingleton* instance;
+    static once_flag flag;
+
+    CallOnceSingleton() {}
+
+public:
+    static CallOnceSingleton* getInstance() {
+        call_once(flag, [] { instance = new CallOnceSingleton(); });
+        return instance;
+    }
+};
+
+CallOnceSingleton* CallOnceSingleton::instance = nullptr;
+once_flag CallOnceSingleton::flag;
+
+// `threads` threads each call getInstance() `calls` times. Reports ns per call per core
+// (wall time x cores in use / total calls), so numbers are comparable across machines.
+template <typename T>
+double hammer(const string& label, int threads, int calls) {
+    atomic<bool> go{false};
+    atomic<uintptr_t> sink{0};
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&] {
+            while (!go.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            uintptr_t acc = 0;
+            for (int i = 0; i < calls; i++) {
+                acc += reinterpret_cast<uintptr_t>(T::getInstance());
+                asm volatile("" : "+r"(acc));   // keep every call
+            }
+            sink.fetch_add(acc, memory_order_relaxed);
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto& th : pool) {
+        th.join();
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    double perCall = ns * min<unsigned>(threads, max(1u, thread::hardware_concurrency())) / (double(threads) * calls);
+    cout << "  " << label << " | " << perCall << " ns per call" << endl;
+    return perCall;
+}
+
+int main() {
+    Singleton* s1 = Singleton::getInstance();
+    Singleton* s2 = Singleton::getInstance();
+
+    // Prints 1 (true) since s1 and s2 point to the same Singleton instance.
+    cout << (s1 == s2) << endl;
+
+    const int threads = 64;
+    const int calls = 2000000;
+    cout << "\n" << threads << " threads x " << calls << " getInstance() calls:" << endl;
+    hammer<LegacyDclSingleton>("racy DCL (3_)       ", threads, calls);
+    hammer<Singleton>("atomic acquire DCL  ", threads, calls);
+    hammer<MeyersSingleton>("Meyers local static ", threads, calls);
+    hammer<CallOnceSingleton>("std::call_once      ", threads, calls);
+}
@@ -0,0 +1,328 @@
+/*
+ * This program demonstrates a **reusable Singleton<T, Policy> template**.
+ *
+ * -----------------
+ * **Why a template:**
+ * - Files 1_ to 5_ each hand-write the same static pointer, private constructor and
+ *   getInstance() for one class. The only thing that really changes between them is
+ *   *when* and *how* the instance gets created.
+ * - Singleton<T, Policy> keeps that choice in a policy picked at compile time, so a class
+ *   only has to make its constructor private and befriend `SingletonAccess`.
+ *
+ * -----------------
+ * **Policies:**
+ * - EagerPolicy      : created during static initialization (like 4_ThreadSafeEagerSigleton).
+ *                      Access is one load of a pointer that never changes.
+ * - LazyPolicy       : Meyers singleton, a function-local static. Thread-safe in C++11,
+ *                      access is a guard check plus a load.
+ * - AtomicDclPolicy  : double-checked locking with acquire/release atomics
+ *                      (5_AtomicDoubleCheckedLocking). Access is one acquire load.
+ * - ThreadLocalPolicy: one instance per thread, destroyed when the thread exits. Not a global
+ *                      singleton; useful for state that must never be shared (scratch
+ *                      buffers, per-thread caches).
+ * - PerNumaNodePolicy: one instance per NUMA node, created lazily by the first thread that
+ *                      runs on that node, so its memory is first-touched locally. The node is
+ *                      looked up once per thread (Linux getcpu); a thread that migrates keeps
+ *                      using its first node's instance.
+ *
+ * -----------------
+ * **Usage:**
+ *     class Config {
+ *         friend struct SingletonAccess;
+ *         Config() {}
+ *     };
+ *     Config& c = Singleton<Config, LazyPolicy>::instance();
+ *
+ * main() checks that each policy constructs exactly once when 64 threads race on the first
+ * call, then compares the per-call cost of every policy.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread 6_SingletonTemplate.cpp
+ */
+
+#include<atomic>
+#include<chrono>
+#include<iostream>
+#include<memory>
+#include<mutex>
+#include<string>
+#include<thread>
+#include<vector>
+#ifdef __linux__
+#include<sched.h>
+#endif
+using namespace std;
+
+// The only class allowed to call T's private constructor.
+struct SingletonAccess {
+    template <typename T>
+    static T* create() {
+        return new T();
+    }
+};
+
+struct EagerPolicy {
+    template <typename T>
+    struct Holder {
+        static T* const instance;
+        static T& get() { return *instance; }
+    };
+};
+
+template <typename T>
+T* const EagerPolicy::Holder<T>::instance = SingletonAccess::create<T>();
+
+struct LazyPolicy {
+    template <typename T>
+    struct Holder {
+        static T& get() {
+            static T* instance = SingletonAccess::create<T>();
+            return *instance;
+        }
+    };
+};
+
+struct AtomicDclPolicy {
+    template <typename T>
+    struct Holder {
+        static atomic<T*> instance;
+        static mutex mtx;
+
+        static T& get() {
+            T* p = instance.load(memory_order_acquire);
+            if (p == nullptr) {
+                p = slowPath();
+            }
+            return *p;
+        }
+
+        static T* slowPath() {
+            lock_guard<mutex> lock(mtx);
+            T* p = instance.load(memory_order_relaxed);
+            if (p == nullptr) {
+                p = SingletonAccess::create<T>();
+                instance.store(p, memory_order_release);
+            }
+            return p;
+        }
+    };
+};
+
+template <typename T>
+atomic<T*> AtomicDclPolicy::Holder<T>::instance{nullptr};
+template <typename T>
+mutex AtomicDclPolicy::Holder<T>::mtx;
+
+struct ThreadLocalPolicy {
+    template <typename T>
+    struct Holder {
+        static T& get() {
+            thread_local unique_ptr<T> instance(SingletonAccess::create<T>());   // destroyed at thread exit
+            return *instance;
+        }
+    };
+};
+
+struct PerNumaNodePolicy {
+    static const unsigned MaxNodes = 64;
+
+    static unsigned currentNode() {
+        thread_local unsigned node = [] {
+            unsigned cpu = 0, n = 0;
+#ifdef __linux__
+            if (getcpu(&cpu, &n) != 0) {
+                n = 0;
+            }
+#endif
+            return n % MaxNodes;
+        }();
+        return node;
+    }
+
+    template <typename T>
+    struct Holder {
+        static atomic<T*> instances[MaxNodes];
+        static mutex mtx;
+
+        static T& get() {
+            atomic<T*>& slot = instances[currentNode()];
+            T* p = slot.load(memory_order_acquire);
+            if (p == nullptr) {
+                lock_guard<mutex> lock(mtx);
+                p = slot.load(memory_order_relaxed);
+                if (p == nullptr) {
+                    p = SingletonAccess::create<T>();
+                    slot.store(p, memory_order_release);
+                }
+            }
+            return *p;
+        }
+    };
+};
+
+template <typename T>
+atomic<T*> PerNumaNodePolicy::Holder<T>::instances[PerNumaNodePolicy::MaxNodes];
+template <typename T>
+mutex PerNumaNodePolicy::Holder<T>::mtx;
+
+template <typename T, typename Policy = LazyPolicy>
+class Singleton {
+public:
+    Singleton() = delete;
+
+    static T& instance() {
+        return Policy::template Holder<T>::get();
+    }
+};
+
+// ---- Example class ----
+
+class Logger {
+private:
+    friend struct SingletonAccess;
+
+    Logger() {
+        cout << "Logger Constructor Called!" << endl;
+    }
+
+public:
+    void log(const string& message) {
+        cout << "[log] " << message << endl;
+    }
+};
+
+// ---- Concurrency check and benchmark ----
+
+// Counts constructions; the sleep widens the window in which racing threads could double-construct.
+template <int Tag>
+class Counted {
+private:
+    friend struct SingletonAccess;
+
+    Counted() {
+        constructions.fetch_add(1);
+        this_thread::sleep_for(chrono::milliseconds(5));
+    }
+
+public:
+    ~Counted() {
+        destructions.fetch_add(1);
+    }
+
+    static atomic<int> constructions;
+    static atomic<int> destructions;
+    uint64_t value = 1;
+};
+
+template <int Tag>
+atomic<int> Counted<Tag>::constructions{0};
+template <int Tag>
+atomic<int> Counted<Tag>::destructions{0};
+
+template <typename V>
+size_t countDistinct(const vector<V>& values) {
+    size_t distinct = 0;
+    for (size_t i = 0; i < values.size(); i++) {
+        bool first = true;
+        for (size_t j = 0; j < i; j++) {
+            if (values[j] == values[i]) {
+                first = false;
+                break;
+            }
+        }
+        distinct += first;
+    }
+    return distinct;
+}
+
+struct RaceResult {
+    size_t instances;   // distinct instances seen
+    size_t nodes;       // distinct NUMA nodes the threads started on
+};
+
+// 64 threads released at once all make the first call. Every thread stays alive until all of
+// them have looked, so a per-thread instance freed at exit cannot be reused by another thread.
+template <typename T, typename Policy>
+RaceResult raceFirstAccess(const string& label, int threads) {
+    atomic<int> ready{0};
+    atomic<int> looked{0};
+    atomic<bool> go{false};
+    vector<T*> seen(threads);
+    vector<unsigned> nodes(threads);
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t] {
+            ready.fetch_add(1);
+            while (!go.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            nodes[t] = PerNumaNodePolicy::currentNode();
+            seen[t] = &Singleton<T, Policy>::instance();
+            looked.fetch_add(1);
+            while (looked.load() < threads) {
+                this_thread::yield();
+            }
+        });
+    }
+    while (ready.load() < threads) {
+        this_thread::yield();
+    }
+    go.store(true, memory_order_release);
+    for (auto& th : pool) {
+        th.join();
+    }
+    RaceResult result{countDistinct(seen), countDistinct(nodes)};
+    cout << "  " << label << " | constructions " << T::constructions.load() << " | destructions "
+         << T::destructions.load() << " | distinct instances " << result.instances << endl;
+    return result;
+}
+
+template <typename T, typename Policy>
+void perCallCost(const string& label) {
+    const int calls = 200000000;
+    Singleton<T, Policy>::instance();   // create outside the timed loop
+    uint64_t acc = 0;
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < calls; i++) {
+        acc += Singleton<T, Policy>::instance().value;
+        asm volatile("" : "+r"(acc));   // keep every call
+    }
+    double ns = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count();
+    cout << "  " << label << " | " << ns / calls << " ns per call" << endl;
+}
+
+int main() {
+    Logger& l1 = Singleton<Logger, AtomicDclPolicy>::instance();
+    Logger& l2 = Singleton<Logger, AtomicDclPolicy>::instance();
+    l1.log("Singleton<Logger, AtomicDclPolicy> ready");
+
+    // Prints 1 (true) since l1 and l2 refer to the same Logger instance.
+    cout << (&l1 == &l2) << endl;
+
+    const int threads = 64;
+    cout << "\n" << threads << " threads racing on the first instance() call:" << endl;
+    bool ok = true;
+    ok &= raceFirstAccess<Counted<1>, EagerPolicy>("Eager      ", threads).instances == 1;
+    ok &= raceFirstAccess<Counted<2>, LazyPolicy>("Lazy       ", threads).instances == 1;
+    ok &= raceFirstAccess<Counted<3>, AtomicDclPolicy>("AtomicDcl  ", threads).instances == 1;
+    ok &= Counted<1>::constructions == 1 && Counted<2>::constructions == 1 && Counted<3>::constructions == 1;
+
+    // One instance per thread, and each one destroyed when its thread exits.
+    RaceResult perThread = raceFirstAccess<Counted<4>, ThreadLocalPolicy>("ThreadLocal", threads);
+    ok &= perThread.instances == size_t(threads) && Counted<4>::constructions == threads &&
+          Counted<4>::destructions == threads;
+
+    // One instance per node the threads ran on (usually a single node on a desktop).
+    RaceResult perNode = raceFirstAccess<Counted<5>, PerNumaNodePolicy>("PerNumaNode", threads);
+    ok &= perNode.instances == perNode.nodes && Counted<5>::constructions == int(perNode.nodes);
+    cout << "  (" << perNode.nodes << " NUMA node(s) seen)" << endl;
+    cout << (ok ? "  construction counts: PASS" : "  construction counts: FAIL") << endl;
+
+    cout << "\nPer-call cost of instance():" << endl;
+    perCallCost<Counted<1>, EagerPolicy>("Eager      ");
+    perCallCost<Counted<2>, LazyPolicy>("Lazy       ");
+    perCallCost<Counted<3>, AtomicDclPolicy>("AtomicDcl  ");
+    perCallCost<Counted<4>, ThreadLocalPolicy>("ThreadLocal");
+    perCallCost<Counted<5>, PerNumaNodePolicy>("PerNumaNode");
+
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,188 @@
+/*
+ * This program demonstrates a **sharded singleton**: one logical instance whose mutable
+ * state is split into per-thread or per-core shards.
+ *
+ * -----------------
+ * **Problem with 4_ThreadSafeEagerSigleton.cpp under load:**
+ * - Every thread gets the same object. Creating it is thread-safe, but any mutable state
+ *   inside it (a request counter, a cache, a pool) lives on the same cache lines.
+ * - When 32 threads increment one `atomic<uint64_t>`, each increment has to pull the line
+ *   into its own core in exclusive state. The line bounces between cores and the "cheap"
+ *   counter becomes the bottleneck.
+ *
+ * -----------------
+ * **Sharded singleton:**
+ * - `ShardedSingleton<T, ShardBy, Shards>` is still created eagerly, exactly once, but it
+ *   holds `Shards` copies of T, each `alignas(64)` so no two shards share a cache line.
+ * - `local()` returns the calling thread's shard:
+ *     - ShardBy::Thread: each thread is assigned a shard on its first call (round robin)
+ *       and keeps it. Cheapest lookup (one thread_local read).
+ *     - ShardBy::Core: the shard of the CPU the thread is running on right now
+ *       (sched_getcpu). Threads sharing a core share a shard, so shard count can match
+ *       core count even with many more threads.
+ * - `aggregate(init, f)` folds every shard on read, e.g. to sum the counters. Reads are
+ *   rarer than writes, so paying O(Shards) there is the right trade.
+ * - Shards can still be touched by two threads (more threads than shards, or a thread
+ *   preempted on one core while another runs there), so shard state stays atomic; the
+ *   atomics are just uncontended now.
+ *
+ * main() has 32 threads increment a request counter through the shared singleton and
+ * through both sharded modes and reports throughput. The gap only shows with several
+ * physical cores; on one core nothing bounces and the modes cost about the same.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread 7_ShardedSingleton.cpp
+ */
+
+#include<atomic>
+#include<chrono>
+#include<iostream>
+#include<string>
+#include<thread>
+#include<vector>
+#ifdef __linux__
+#include<sched.h>
+#endif
+using namespace std;
+
+enum class ShardBy { Thread, Core };
+
+template <typename T, ShardBy By = ShardBy::Thread, size_t Shards = 64>
+class ShardedSingleton {
+private:
+    struct alignas(64) Shard {
+        T value;
+    };
+
+    static ShardedSingleton* instance;
+
+    Shard shards[Shards];
+    atomic<size_t> nextThread{0};
+
+    ShardedSingleton() {
+        cout << "ShardedSingleton Constructor Called!" << endl;
+    }
+
+    size_t threadShard() {
+        thread_local size_t index = nextThread.fetch_add(1, memory_order_relaxed) % Shards;
+        return index;
+    }
+
+    static size_t coreShard() {
+#ifdef __linux__
+        int cpu = sched_getcpu();
+        return cpu < 0 ? 0 : size_t(cpu) % Shards;
+#else
+        return 0;
+#endif
+    }
+
+public:
+    static ShardedSingleton* getInstance() {
+        return instance;
+    }
+
+    // The shard the calling thread should write to.
+    T& local() {
+        return shards[By == ShardBy::Thread ? threadShard() : coreShard()].value;
+    }
+
+    // Folds every shard: init = f(init, shard) for each shard in order.
+    template <typename R, typename F>
+    R aggregate(R init, F f) const {
+        for (const Shard& s : shards) {
+            init = f(init, s.value);
+        }
+        return init;
+    }
+
+    static constexpr size_t shardCount() {
+        return Shards;
+    }
+};
+
+// Initialize static members
+template <typename T, ShardBy By, size_t Shards>
+ShardedSingleton<T, By, Shards>* ShardedSingleton<T, By, Shards>::instance = new ShardedSingleton<T, By, Shards>();
+
+// ---- Shard state ----
+
+struct RequestStats {
+    atomic<uint64_t> requests{0};
+};
+
+template <ShardBy By>
+uint64_t totalRequests(const ShardedSingleton<RequestStats, By>* s) {
+    return s->aggregate(uint64_t(0), [](uint64_t sum, const RequestStats& r) {
+        return sum + r.requests.load(memory_order_relaxed);
+    });
+}
+
+// ---- Baseline: the eager singleton from 4_ with one shared counter ----
+
+class SharedStats {
+private:
+    static SharedStats* instance;
+
+    SharedStats() {}
+
+public:
+    atomic<uint64_t> requests{0};
+
+    static SharedStats* getInstance() {
+        return instance;
+    }
+};
+
+SharedStats* SharedStats::instance = new SharedStats();
+
+// ---- Benchmark ----
+
+template <typename Increment, typename Total>
+void run(const string& label, int threads, int perThread, Increment increment, Total total) {
+    atomic<bool> go{false};
+    vector<thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&] {
+            while (!go.load(memory_order_acquire)) {
+                this_thread::yield();
+            }
+            for (int i = 0; i < perThread; i++) {
+                increment();
+            }
+        });
+    }
+    auto start = chrono::steady_clock::now();
+    go.store(true, memory_order_release);
+    for (auto& th : pool) {
+        th.join();
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    uint64_t expected = uint64_t(threads) * perThread;
+    cout << "  " << label << " | " << (expected / secs) / 1e6 << " M increments/s | total " << total()
+         << (total() == expected ? " (ok)" : " (WRONG)") << endl;
+}
+
+int main() {
+    auto* s1 = ShardedSingleton<RequestStats>::getInstance();
+    auto* s2 = ShardedSingleton<RequestStats>::getInstance();
+
+    // Prints 1 (true) since s1 and s2 point to the same ShardedSingleton instance.
+    cout << (s1 == s2) << endl;
+
+    const int threads = 32;
+    const int perThread = 2000000;
+    cout << "\n" << threads << " threads x " << perThread << " increments ("
+         << thread::hardware_concurrency() << " hardware threads):" << endl;
+
+    run("shared atomic       ", threads, perThread,
+        [] { SharedStats::getInstance()->requests.fetch_add(1, memory_order_relaxed); },
+        [] { return SharedStats::getInstance()->requests.load(); });
+
+    run("sharded per thread  ", threads, perThread,
+        [] { ShardedSingleton<RequestStats, ShardBy::Thread>::getInstance()->local().requests.fetch_add(1, memory_order_relaxed); },
+        [] { return totalRequests(ShardedSingleton<RequestStats, ShardBy::Thread>::getInstance()); });
+
+    run("sharded per core    ", threads, perThread,
+        [] { ShardedSingleton<RequestStats, ShardBy::Core>::getInstance()->local().requests.fetch_add(1, memory_order_relaxed); },
+        [] { return totalRequests(ShardedSingleton<RequestStats, ShardBy::Core>::getInstance()); });
+}
@@ -0,0 +1,326 @@
+/*
+ * This program demonstrates a **singleton lifetime registry**: several singletons with
+ * declared dependencies, constructed lazily (or in parallel at startup) and destroyed in
+ * reverse dependency order at shutdown.
+ *
+ * -----------------
+ * **Problems with the earlier singleton files:**
+ * - `new Singleton()` is never deleted, so destructors (flush a log, close connections)
+ *   never run.
+ * - Nothing orders several singletons. If a ConnectionPool needs Config and Logger, it
+ *   only works if they happen to be created first; at exit, static destruction order across
+ *   translation units is unspecified.
+ * - Startup is serial: every singleton created eagerly adds its full construction time,
+ *   even when it does not depend on the others.
+ *
+ * -----------------
+ * **SingletonRegistry:**
+ * - `define<T>("name", {"dep", ...})` declares a singleton and what it needs. Dependencies
+ *   must already be defined, so the graph is always acyclic.
+ * - `get<T>()` constructs T lazily: dependencies first, then T, each exactly once
+ *   (`std::call_once` per entry). Concurrent callers wait on the same once_flag.
+ * - `startup()` constructs every defined singleton in parallel. Each one runs on its own
+ *   thread and simply calls into its dependencies first, so independent singletons overlap
+ *   and dependent ones wait only for what they actually need.
+ * - Every construction records its start and end time; `report()` prints them next to the
+ *   serial total to show what parallel init saved.
+ * - `shutdown()` destroys instances in reverse completion order. An instance completes
+ *   only after all its dependencies, so that order is a valid reverse-topological order.
+ *   Destructors run outside the registry lock, so they may still call report(); a get()
+ *   after shutdown throws instead of handing out a destroyed instance.
+ *   The registry itself is a Meyers singleton and calls shutdown() from its destructor.
+ *
+ * main() defines five services whose constructors sleep to stand in for I/O (reading
+ * files, opening connections), starts them in parallel, then shuts down.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread 8_SingletonLifetimeRegistry.cpp
+ */
+
+#include<chrono>
+#include<exception>
+#include<functional>
+#include<iomanip>
+#include<iostream>
+#include<memory>
+#include<mutex>
+#include<stdexcept>
+#include<string>
+#include<thread>
+#include<typeindex>
+#include<unordered_map>
+#include<vector>
+using namespace std;
+
+class SingletonRegistry {
+private:
+    struct Entry {
+        string name;
+        vector<Entry*> deps;
+        function<void*()> create;
+        function<void(void*)> destroy;
+        void* object = nullptr;
+        once_flag once;
+        double startMs = 0;
+        double endMs = 0;
+    };
+
+    unordered_map<string, unique_ptr<Entry>> byName;
+    unordered_map<type_index, Entry*> byType;
+    vector<Entry*> defined;       // definition order
+    vector<Entry*> constructed;   // completion order, guarded by mtx
+    mutex mtx;
+    bool shutDown = false;
+    chrono::steady_clock::time_point epoch = chrono::steady_clock::now();
+
+    SingletonRegistry() {}
+
+    double nowMs() const {
+        return chrono::duration<double, milli>(chrono::steady_clock::now() - epoch).count();
+    }
+
+    void ensure(Entry* e) {
+        call_once(e->once, [this, e] {
+            for (Entry* dep : e->deps) {
+                ensure(dep);
+            }
+            {
+                lock_guard<mutex> lock(mtx);
+                if (shutDown) {
+                    throw logic_error("SingletonRegistry: '" + e->name + "' requested after shutdown");
+                }
+            }
+            double start = nowMs();
+            void* object = e->create();
+            e->startMs = start;
+            e->endMs = nowMs();
+            e->object = object;
+            lock_guard<mutex> lock(mtx);
+            constructed.push_back(e);
+        });
+    }
+
+public:
+    SingletonRegistry(const SingletonRegistry&) = delete;
+    SingletonRegistry& operator=(const SingletonRegistry&) = delete;
+
+    static SingletonRegistry& getInstance() {
+        static SingletonRegistry instance;
+        return instance;
+    }
+
+    ~SingletonRegistry() {
+        shutdown();
+    }
+
+    // Declares singleton T. Call before any get()/startup(); definitions are not thread-safe.
+    template <typename T>
+    void define(const string& name, const vector<string>& deps = {}) {
+        if (byName.count(name) || byType.count(type_index(typeid(T)))) {
+            throw invalid_argument("SingletonRegistry: '" + name + "' is already defined");
+        }
+        auto e = make_unique<Entry>();
+        e->name = name;
+        for (const string& dep : deps) {
+            auto it = byName.find(dep);
+            if (it == byName.end()) {
+                throw invalid_argument("SingletonRegistry: '" + name + "' depends on undefined '" + dep + "'");
+            }
+            e->deps.push_back(it->second.get());
+        }
+        e->create = [] { return static_cast<void*>(new T()); };
+        e->destroy = [](void* p) { delete static_cast<T*>(p); };
+        byType[type_index(typeid(T))] = e.get();
+        defined.push_back(e.get());
+        byName[name] = move(e);
+    }
+
+    template <typename T>
+    T& get() {
+        auto it = byType.find(type_index(typeid(T)));
+        if (it == byType.end()) {
+            throw logic_error(string("SingletonRegistry: type not defined: ") + typeid(T).name());
+        }
+        ensure(it->second);
+        // once_flag only fires once, so a get() after shutdown() has to be caught here.
+        lock_guard<mutex> lock(mtx);
+        if (shutDown || it->second->object == nullptr) {
+            throw logic_error("SingletonRegistry: '" + it->second->name + "' requested after shutdown");
+        }
+        return *static_cast<T*>(it->second->object);
+    }
+
+    // Constructs every defined singleton, independent ones in parallel.
+    void startup() {
+        vector<thread> pool;
+        vector<exception_ptr> errors(defined.size());
+        for (size_t i = 0; i < defined.size(); i++) {
+            pool.emplace_back([this, i, &errors] {
+                try {
+                    ensure(defined[i]);
+                } catch (...) {
+                    errors[i] = current_exception();
+                }
+            });
+        }
+        for (auto& th : pool) {
+            th.join();
+        }
+        for (auto& err : errors) {
+            if (err) {
+                rethrow_exception(err);
+            }
+        }
+    }
+
+    // Destroys everything constructed so far, dependents before their dependencies.
+    // Destructors run without mtx held, so they may call get() (which throws) or report().
+    void shutdown() {
+        vector<pair<Entry*, void*>> doomed;
+        {
+            lock_guard<mutex> lock(mtx);
+            shutDown = true;
+            for (auto it = constructed.rbegin(); it != constructed.rend(); ++it) {
+                doomed.push_back({*it, (*it)->object});
+                (*it)->object = nullptr;
+            }
+            constructed.clear();
+        }
+        for (auto& [e, object] : doomed) {
+            e->destroy(object);
+        }
+    }
+
+    void report() {
+        lock_guard<mutex> lock(mtx);
+        double serial = 0, first = 1e300, last = 0;
+        for (Entry* e : constructed) {
+            first = min(first, e->startMs);
+            last = max(last, e->endMs);
+        }
+        cout << fixed << setprecision(1);
+        for (Entry* e : constructed) {
+            double took = e->endMs - e->startMs;
+            serial += took;
+            cout << "  " << left << setw(12) << e->name << right << " start " << setw(6) << e->startMs - first
+                 << " ms  took " << setw(6) << took << " ms" << endl;
+        }
+        if (!constructed.empty()) {
+            cout << "  wall " << last - first << " ms vs serial " << serial << " ms" << endl;
+        }
+        cout.unsetf(ios::floatfield);
+    }
+};
+
+// ---- Example services ----
+// Constructors sleep to stand in for real startup work.
+
+class Config {
+private:
+    friend class SingletonRegistry;
+
+    Config() {
+        this_thread::sleep_for(chrono::milliseconds(30));
+    }
+
+public:
+    ~Config() {
+        cout << "Config Destructor Called!" << endl;
+    }
+
+    int poolSize = 4;
+};
+
+class Logger {
+private:
+    friend class SingletonRegistry;
+
+    Logger() {
+        SingletonRegistry::getInstance().get<Config>();
+        this_thread::sleep_for(chrono::milliseconds(20));
+    }
+
+public:
+    ~Logger() {
+        cout << "Logger Destructor Called!" << endl;
+    }
+};
+
+class Metrics {
+private:
+    friend class SingletonRegistry;
+
+    Metrics() {
+        this_thread::sleep_for(chrono::milliseconds(40));
+    }
+
+public:
+    ~Metrics() {
+        cout << "Metrics Destructor Called!" << endl;
+    }
+};
+
+class ConnectionPool {
+private:
+    friend class SingletonRegistry;
+
+    int size;
+
+    ConnectionPool() : size(SingletonRegistry::getInstance().get<Config>().poolSize) {
+        SingletonRegistry::getInstance().get<Logger>();
+        this_thread::sleep_for(chrono::milliseconds(50));
+    }
+
+public:
+    ~ConnectionPool() {
+        cout << "ConnectionPool Destructor Called! (" << size << " connections closed)" << endl;
+    }
+};
+
+class Cache {
+private:
+    friend class SingletonRegistry;
+
+    Cache() {
+        SingletonRegistry::getInstance().get<Config>();
+        this_thread::sleep_for(chrono::milliseconds(30));
+    }
+
+public:
+    ~Cache() {
+        cout << "Cache Destructor Called!" << endl;
+        // Destructors run outside the registry lock, so calling report() here is safe (entries
+        // are already released, so it prints nothing).
+        SingletonRegistry::getInstance().report();
+    }
+};
+
+int main() {
+    SingletonRegistry& registry = SingletonRegistry::getInstance();
+    registry.define<Config>("config");
+    registry.define<Logger>("logger", {"config"});
+    registry.define<Metrics>("metrics");
+    registry.define<ConnectionPool>("pool", {"config", "logger"});
+    registry.define<Cache>("cache", {"config"});
+
+    registry.startup();
+    cout << "Parallel startup:" << endl;
+    registry.report();
+
+    Logger& l1 = registry.get<Logger>();
+    Logger& l2 = registry.get<Logger>();
+
+    // Prints 1 (true) since l1 and l2 refer to the same Logger instance.
+    cout << (&l1 == &l2) << endl;
+
+    cout << "Shutdown:" << endl;
+    registry.shutdown();
+
+    // Singletons are gone for good after shutdown().
+    try {
+        registry.get<Logger>();
+        cout << "get after shutdown: FAILED, no exception" << endl;
+        return 1;
+    } catch (const logic_error& e) {
+        cout << "get after shutdown throws: " << e.what() << endl;
+    }
+}
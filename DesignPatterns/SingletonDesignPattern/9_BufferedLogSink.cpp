@@ -0,0 +1,534 @@
+/*
+ * This program demonstrates a **process-wide buffered log sink** (a Meyers singleton) that
+ * replaces `cout << ... << endl` in hot paths.
+ *
+ * -----------------
+ * **Why `cout << ... << endl` is slow under load:**
+ * - `endl` flushes, so every line is a separate write() system call.
+ * - All threads share one stream, so concurrent writers serialize on its lock (and lines
+ *   from different threads can interleave mid-line).
+ * - Formatting happens even for messages nobody wants to see (debug output in production).
+ *
+ * -----------------
+ * **LogSink:**
+ * - Each thread gets its own ring buffer (single producer, single consumer) the first time it
+ *   logs. A finished line is copied into the ring with one memcpy and published with one
+ *   release store. No locks and no system calls on the logging path.
+ * - One background flusher drains every ring into a large staging block and writes it with a
+ *   single fwrite. It wakes every 10ms, or early when a ring is half full.
+ * - Lines up to half a ring (512KiB) are never split; lines from different threads are not
+ *   ordered relative to each other. A longer line is committed in pieces, so it is written in
+ *   full but another thread's output may land between its pieces.
+ * - If a ring is full the logging thread waits for the flusher (backpressure, nothing is
+ *   dropped).
+ * - `flush()` waits until everything logged so far has been written. The sink drains itself
+ *   when it is destroyed at exit.
+ *
+ * -----------------
+ * **Compile-time level elimination:**
+ * - `LOG_DEBUG(...)`, `LOG_INFO(...)`, `LOG_WARN(...)`, `LOG_ERROR(...)` take the same
+ *   `<<` chain you would give cout. Below `LOG_MIN_LEVEL` (default Info) the statement is
+ *   discarded by `if constexpr`: no code is generated and the arguments are never evaluated.
+ *   Build with -DLOG_MIN_LEVEL=0 to keep debug lines.
+ *
+ * -----------------
+ * **Drop-in use:**
+ *     cout << "Walking normally..." << endl;      becomes      LOG_INFO("Walking normally...");
+ * - Every line starts with its level, e.g. `[INFO] Walking normally...`.
+ * - `<<` takes strings, chars, numbers, bools (printed as 1/0 like cout), pointers (hex) and
+ *   `endl` / `flush`, which are accepted and ignored: the statement already ends the line and
+ *   the sink does its own flushing. Stream-state manipulators (hex, setw, setprecision, ...)
+ *   are not supported and fail to compile, so code relying on them has to keep using cout.
+ * main() shows it inside NormalWalk::walk, Subscriber::update, SavingAccount::deposit and
+ * CartInvoicePrinter::printInvoice, then compares 16 threads logging through cout + endl
+ * with the sink. Output goes to /dev/null during the benchmark, so only the cost of getting
+ * the bytes out of the program is measured.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread 9_BufferedLogSink.cpp
+ */
+
+#include<algorithm>
+#include<atomic>
+#include<charconv>
+#include<chrono>
+#include<condition_variable>
+#include<cstdio>
+#include<cstdint>
+#include<cstring>
+#include<fcntl.h>
+#include<iostream>
+#include<memory>
+#include<mutex>
+#include<string>
+#include<string_view>
+#include<thread>
+#include<type_traits>
+#include<unistd.h>
+#include<vector>
+using namespace std;
+
+#ifndef LOG_MIN_LEVEL
+#define LOG_MIN_LEVEL 1   // 0 = Debug, 1 = Info, 2 = Warn, 3 = Error
+#endif
+
+enum class LogLevel { Debug = 0, Info = 1, Warn = 2, Error = 3 };
+
+class LogSink {
+private:
+    // Per-thread byte ring. The owning thread advances head, the flusher advances tail.
+    struct Ring {
+        static const size_t Capacity = 1 << 20;   // power of two
+
+        alignas(64) atomic<size_t> head{0};
+        alignas(64) atomic<size_t> tail{0};
+        atomic<bool> retired{false};              // owning thread has exited
+        uint64_t id;
+        unique_ptr<char[]> data{new char[Capacity]};
+
+        Ring(uint64_t id) : id(id) {}
+    };
+
+    // Gives the thread's ring back to the flusher when the thread exits.
+    struct ThreadState {
+        Ring* ring = nullptr;
+
+        ~ThreadState() {
+            if (ring) {
+                ring->retired.store(true, memory_order_release);
+            }
+        }
+    };
+
+    static const size_t StagingSize = 1 << 20;
+
+    mutex registryMtx;                 // guards rings; taken once per thread, never per line
+    vector<unique_ptr<Ring>> rings;
+    uint64_t nextRingId = 0;           // guarded by registryMtx
+    mutex wakeMtx;
+    condition_variable wakeCv;
+    atomic<bool> wakeRequested{false};
+    atomic<bool> stopping{false};
+    atomic<uint64_t> passes{0};        // completed flusher passes, each ends with a write
+    FILE* out = stdout;
+    unique_ptr<char[]> staging{new char[StagingSize]};
+    size_t stagingUsed = 0;
+    thread flusher;
+
+    LogSink() : flusher([this] { run(); }) {}
+
+    Ring& threadRing() {
+        thread_local ThreadState state;
+        if (state.ring == nullptr) {
+            lock_guard<mutex> lock(registryMtx);
+            rings.push_back(make_unique<Ring>(nextRingId++));
+            state.ring = rings.back().get();
+        }
+        return *state.ring;
+    }
+
+    void writeStaging() {
+        if (stagingUsed > 0) {
+            fwrite(staging.get(), 1, stagingUsed, out);
+            fflush(out);
+            stagingUsed = 0;
+        }
+    }
+
+    // Copies everything readable from `ring` into staging. Flusher thread only.
+    bool drain(Ring& ring) {
+        size_t tail = ring.tail.load(memory_order_relaxed);
+        size_t head = ring.head.load(memory_order_acquire);
+        if (tail == head) {
+            return false;
+        }
+        while (tail != head) {
+            size_t offset = tail & (Ring::Capacity - 1);
+            size_t chunk = min({head - tail, Ring::Capacity - offset, StagingSize - stagingUsed});
+            memcpy(staging.get() + stagingUsed, ring.data.get() + offset, chunk);
+            stagingUsed += chunk;
+            tail += chunk;
+            if (stagingUsed == StagingSize) {
+                writeStaging();
+            }
+        }
+        ring.tail.store(tail, memory_order_release);
+        return true;
+    }
+
+    void run() {
+        vector<Ring*> snapshot;
+        while (true) {
+            bool stop = stopping.load(memory_order_acquire);
+            snapshot.clear();
+            {
+                lock_guard<mutex> lock(registryMtx);
+                for (auto& ring : rings) {
+                    snapshot.push_back(ring.get());
+                }
+            }
+            bool wrote = false;
+            for (Ring* ring : snapshot) {
+                wrote |= drain(*ring);
+            }
+            writeStaging();
+            passes.fetch_add(1, memory_order_release);
+            {
+                // Free rings whose threads have exited and whose data has been written.
+                lock_guard<mutex> lock(registryMtx);
+                rings.erase(remove_if(rings.begin(), rings.end(), [](const unique_ptr<Ring>& r) {
+                                return r->retired.load(memory_order_acquire) &&
+                                       r->tail.load(memory_order_relaxed) == r->head.load(memory_order_acquire);
+                            }),
+                            rings.end());
+            }
+            if (stop) {
+                return;
+            }
+            if (!wrote) {
+                unique_lock<mutex> lock(wakeMtx);
+                wakeCv.wait_for(lock, chrono::milliseconds(10), [this] {
+                    return wakeRequested.load(memory_order_relaxed) || stopping.load(memory_order_relaxed);
+                });
+                wakeRequested.store(false, memory_order_relaxed);
+            }
+        }
+    }
+
+    void wake() {
+        if (!wakeRequested.exchange(true, memory_order_relaxed)) {
+            wakeCv.notify_one();
+        }
+    }
+
+public:
+    LogSink(const LogSink&) = delete;
+    LogSink& operator=(const LogSink&) = delete;
+
+    static LogSink& instance() {
+        static LogSink sink;
+        return sink;
+    }
+
+    ~LogSink() {
+        stopping.store(true, memory_order_release);
+        wakeCv.notify_one();
+        flusher.join();
+    }
+
+    // Appends one complete line (including its '\n') to the calling thread's ring. A line
+    // longer than half the ring goes in several pieces rather than being cut short.
+    void commit(const char* line, size_t n) {
+        Ring& ring = threadRing();
+        const size_t maxPiece = Ring::Capacity / 2;
+        while (n > maxPiece) {
+            commitPiece(ring, line, maxPiece);
+            line += maxPiece;
+            n -= maxPiece;
+        }
+        commitPiece(ring, line, n);
+    }
+
+private:
+    void commitPiece(Ring& ring, const char* line, size_t n) {
+        size_t head = ring.head.load(memory_order_relaxed);
+        size_t tail = ring.tail.load(memory_order_acquire);
+        while (Ring::Capacity - (head - tail) < n) {
+            wake();
+            this_thread::yield();
+            tail = ring.tail.load(memory_order_acquire);
+        }
+        size_t offset = head & (Ring::Capacity - 1);
+        size_t first = min(n, Ring::Capacity - offset);
+        memcpy(ring.data.get() + offset, line, first);
+        memcpy(ring.data.get(), line + first, n - first);
+        ring.head.store(head + n, memory_order_release);
+        if (head - tail < Ring::Capacity / 2 && head + n - tail >= Ring::Capacity / 2) {
+            wake();
+        }
+    }
+
+public:
+
+    // Blocks until every line committed before the call has been written.
+    void flush() {
+        // Rings are only read under registryMtx: the flusher frees drained rings of exited threads.
+        vector<pair<uint64_t, size_t>> targets;   // ring id, head at the time of the call
+        {
+            lock_guard<mutex> lock(registryMtx);
+            for (auto& ring : rings) {
+                targets.push_back({ring->id, ring->head.load(memory_order_acquire)});
+            }
+        }
+        while (true) {
+            bool done = true;
+            {
+                lock_guard<mutex> lock(registryMtx);
+                size_t t = 0;
+                for (auto& ring : rings) {
+                    while (t < targets.size() && targets[t].first < ring->id) {
+                        t++;   // freed, so it was fully drained
+                    }
+                    if (t < targets.size() && targets[t].first == ring->id &&
+                        ring->tail.load(memory_order_acquire) < targets[t].second) {
+                        done = false;
+                        break;
+                    }
+                }
+            }
+            if (done) {
+                break;
+            }
+            wake();
+            this_thread::yield();
+        }
+        // tail moves once bytes are staged; the pass that staged them writes them before it ends.
+        uint64_t seen = passes.load(memory_order_acquire);
+        while (passes.load(memory_order_acquire) == seen) {
+            wake();
+            this_thread::yield();
+        }
+    }
+};
+
+// Formats one line on the stack and hands it to the sink when the statement ends.
+class LogLine {
+private:
+    static const size_t InlineSize = 256;
+
+    char inlineBuf[InlineSize];
+    size_t len = 0;
+    string spill;   // used only by lines longer than InlineSize
+
+    void append(const char* p, size_t n) {
+        if (spill.empty() && len + n <= InlineSize) {
+            memcpy(inlineBuf + len, p, n);
+            len += n;
+            return;
+        }
+        if (spill.empty()) {
+            spill.assign(inlineBuf, len);
+        }
+        spill.append(p, n);
+    }
+
+    static string_view tagOf(LogLevel level) {
+        switch (level) {
+            case LogLevel::Debug: return "[DEBUG] ";
+            case LogLevel::Info: return "[INFO] ";
+            case LogLevel::Warn: return "[WARN] ";
+            default: return "[ERROR] ";
+        }
+    }
+
+public:
+    explicit LogLine(LogLevel level) {
+        *this << tagOf(level);
+    }
+
+    ~LogLine() {
+        append("\n", 1);
+        if (spill.empty()) {
+            LogSink::instance().commit(inlineBuf, len);
+        } else {
+            LogSink::instance().commit(spill.data(), spill.size());
+        }
+    }
+
+    LogLine& operator<<(string_view s) {
+        append(s.data(), s.size());
+        return *this;
+    }
+
+    LogLine& operator<<(const char* s) {
+        return *this << string_view(s);
+    }
+
+    LogLine& operator<<(const string& s) {
+        return *this << string_view(s);
+    }
+
+    LogLine& operator<<(char c) {
+        append(&c, 1);
+        return *this;
+    }
+
+    LogLine& operator<<(bool b) {
+        return *this << (b ? '1' : '0');
+    }
+
+    LogLine& operator<<(const void* p) {
+        char buf[2 + 2 * sizeof(void*)] = {'0', 'x'};
+        auto result = to_chars(buf + 2, buf + sizeof(buf), uintptr_t(p), 16);
+        append(buf, result.ptr - buf);
+        return *this;
+    }
+
+    // endl / flush: the statement already ends the line, and the sink flushes on its own.
+    LogLine& operator<<(ostream& (*)(ostream&)) {
+        return *this;
+    }
+
+    template <typename T, typename = enable_if_t<is_arithmetic_v<T> && !is_same_v<T, bool>>>
+    LogLine& operator<<(T value) {
+        char buf[64];
+        auto result = to_chars(buf, buf + sizeof(buf), value);
+        append(buf, result.ptr - buf);
+        return *this;
+    }
+};
+
+#define LOG_AT(level, expr)                                \
+    do {                                                   \
+        if constexpr (int(level) >= LOG_MIN_LEVEL) {       \
+            LogLine(level) << expr;                        \
+        }                                                  \
+    } while (0)
+
+#define LOG_DEBUG(expr) LOG_AT(LogLevel::Debug, expr)
+#define LOG_INFO(expr) LOG_AT(LogLevel::Info, expr)
+#define LOG_WARN(expr) LOG_AT(LogLevel::Warn, expr)
+#define LOG_ERROR(expr) LOG_AT(LogLevel::Error, expr)
+
+// ---- The sink dropped into classes from the other examples ----
+
+// StrategyDesignPatterns/main.cpp
+class NormalWalk {
+public:
+    void walk() {
+        LOG_INFO("Walking normally...");
+    }
+};
+
+// ObserverDesignPattern/main.cpp
+class Subscriber {
+private:
+    string subscriberName;
+
+public:
+    Subscriber(string name) : subscriberName(name) {}
+
+    void update() {
+        LOG_INFO("Subscriber " << subscriberName << " has been notified of new content!");
+    }
+};
+
+// SOLID/LSP/lsp_followed.cpp
+class SavingAccount {
+private:
+    double balance = 0;
+
+public:
+    void deposit(double amount) {
+        balance += amount;
+        LOG_INFO("Deposited: " << amount << " in Savings Account. New Balance: " << balance);
+    }
+};
+
+// SOLID/SRP/srp_followed.cpp
+class CartInvoicePrinter {
+private:
+    vector<pair<string, int>> products;
+
+public:
+    CartInvoicePrinter(vector<pair<string, int>> products) : products(products) {}
+
+    void printInvoice() const {
+        LOG_INFO("Invoice: ");
+        for (auto& product : products) {
+            LOG_INFO("Product: " << product.first << ", Price: " << product.second);
+        }
+    }
+};
+
+// ---- Benchmark ----
+
+static atomic<int> expensiveCalls{0};
+
+static int expensiveDebugValue() {
+    expensiveCalls.fetch_add(1);
+    return 42;
+}
+
+// Sends stdout to /dev/null while `f` runs. Returns seconds taken.
+template <typename F>
+double timedToDevNull(F f) {
+    fflush(stdout);
+    int saved = dup(1);
+    int devNull = open("/dev/null", O_WRONLY);
+    dup2(devNull, 1);
+    close(devNull);
+    auto start = chrono::steady_clock::now();
+    f();
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    fflush(stdout);
+    dup2(saved, 1);
+    close(saved);
+    return secs;
+}
+
+template <typename LogOne>
+double logFromThreads(int threads, int linesPerThread, LogOne logOne) {
+    return timedToDevNull([&] {
+        vector<thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&, t] {
+                for (int i = 0; i < linesPerThread; i++) {
+                    logOne(t, i);
+                }
+            });
+        }
+        for (auto& th : pool) {
+            th.join();
+        }
+        LogSink::instance().flush();
+    });
+}
+
+int main() {
+    NormalWalk().walk();
+    Subscriber("Alice").update();
+    SavingAccount().deposit(100);
+    CartInvoicePrinter({{"Apple", 100}, {"Banana", 40}}).printInvoice();
+
+    // The usual cout chain, endl included.
+    int answer = 42;
+    LOG_WARN("ready: " << true << ", answer at " << &answer << endl);
+
+    // Longer than half a ring: written in pieces, nothing cut off.
+    string longLine(700000, 'x');
+    LOG_ERROR(longLine);
+
+    // Discarded at compile time with the default LOG_MIN_LEVEL: the argument is never evaluated.
+    LOG_DEBUG("debug value " << expensiveDebugValue());
+    LogSink::instance().flush();
+
+    LogSink* s1 = &LogSink::instance();
+    LogSink* s2 = &LogSink::instance();
+
+    // Prints 1 (true) since s1 and s2 point to the same LogSink instance.
+    cout << (s1 == s2) << endl;
+    cout << "LOG_DEBUG argument evaluated " << expensiveCalls.load() << " times (LOG_MIN_LEVEL="
+         << LOG_MIN_LEVEL << ")" << endl;
+
+    const int threads = 16;
+    const int linesPerThread = 625000;
+    const double lines = double(threads) * linesPerThread;
+    cout << "\n" << threads << " threads x " << linesPerThread << " lines to /dev/null:" << endl;
+
+    double coutSecs = logFromThreads(threads, linesPerThread, [](int t, int i) {
+        cout << "Walking normally... robot " << t << " step " << i << endl;
+    });
+    cout << "  cout + endl | " << lines / coutSecs / 1e6 << " M lines/s" << endl;
+
+    double sinkSecs = logFromThreads(threads, linesPerThread, [](int t, int i) {
+        LOG_INFO("Walking normally... robot " << t << " step " << i);
+    });
+    cout << "  LogSink     | " << lines / sinkSecs / 1e6 << " M lines/s (" << coutSecs / sinkSecs << "x)" << endl;
+
+    double debugSecs = logFromThreads(threads, linesPerThread, [](int t, int i) {
+        LOG_DEBUG("Walking normally... robot " << t << " step " << i);
+    });
+    cout << "  LOG_DEBUG   | " << debugSecs * 1e3 << " ms total" << (LOG_MIN_LEVEL > 0 ? " (compiled out)" : "") << endl;
+
+    return 0;
+}
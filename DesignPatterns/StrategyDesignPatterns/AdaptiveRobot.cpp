@@ -0,0 +1,329 @@
+/*
+ * Adaptive Strategy Example
+ * -------------------------
+ * In main.cpp a person picks each robot's behaviors when the robot is constructed. When several
+ * implementations of the same behavior exist and which one is fastest depends on conditions
+ * that change at runtime (terrain, load, data size), a fixed choice is eventually wrong.
+ *
+ * AdaptiveSelector<Interface> holds several interchangeable strategies and routes each call to
+ * the one that is currently fastest, based on measurements of live calls:
+ *   - Most calls go straight to the current best candidate and are not timed at all.
+ *   - Every SampleEvery-th call to the best candidate is timed, so a slowdown is noticed.
+ *   - Every ProbeEvery-th call is sent to the next candidate in round robin and timed
+ *     (periodic re-probing), so a candidate that has become faster gets noticed too.
+ *   - Each candidate keeps an exponentially weighted moving average of its latency; the best
+ *     is the one with the lowest average.
+ *
+ * AdaptiveWalk, AdaptiveTalk and AdaptiveFly wrap a selector behind the usual WalkableRobot /
+ * TalkableRobot / FlyableRobot interfaces, so a Robot cannot tell it has one. A selector is
+ * meant to be used from one thread (each robot is driven by one thread).
+ *
+ * main() benchmarks three walking strategies over terrain that changes from flat to rough
+ * halfway through the run, so the best implementation changes mid-run.
+ *
+ * Build: g++ -std=c++17 -O2 AdaptiveRobot.cpp
+ */
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// --- Strategy Interface for Walk ---
+class WalkableRobot {
+public:
+    virtual void walk() = 0;
+    virtual ~WalkableRobot() {}
+};
+
+// --- Strategy Interface for Talk ---
+class TalkableRobot {
+public:
+    virtual void talk() = 0;
+    virtual ~TalkableRobot() {}
+};
+
+// --- Strategy Interface for Fly ---
+class FlyableRobot {
+public:
+    virtual void fly() = 0;
+    virtual ~FlyableRobot() {}
+};
+
+// --- Selector ---
+template <typename Interface>
+class AdaptiveSelector {
+public:
+    static const uint64_t ProbeEvery = 128;   // one call in 128 tries another candidate
+    static const uint64_t SampleEvery = 16;   // one call in 16 to the best candidate is timed
+
+private:
+    struct Candidate {
+        string name;
+        unique_ptr<Interface> strategy;
+        double avgNs = 0;       // EWMA latency, valid once samples > 0
+        uint64_t samples = 0;   // timed calls; a coarse clock can legitimately report 0 ns
+        uint64_t calls = 0;
+    };
+
+    vector<Candidate> candidates;
+    size_t best = 0;
+    size_t nextProbe = 0;
+    uint64_t totalCalls = 0;
+    double alpha;
+
+    void record(size_t i, double ns) {
+        Candidate& c = candidates[i];
+        c.avgNs = c.samples++ == 0 ? ns : c.avgNs + alpha * (ns - c.avgNs);
+        for (size_t j = 0; j < candidates.size(); j++) {
+            if (candidates[j].samples == 0) {
+                continue;
+            }
+            if (candidates[best].samples == 0 || candidates[j].avgNs < candidates[best].avgNs) {
+                best = j;
+            }
+        }
+    }
+
+public:
+    // `alpha` is the EWMA weight of a new measurement: higher reacts faster but is noisier.
+    AdaptiveSelector(double alpha = 0.2) : alpha(alpha) {}
+
+    void add(const string& name, Interface* strategy) {
+        candidates.push_back(Candidate{name, unique_ptr<Interface>(strategy)});
+    }
+
+    // Calls f(strategy) on the chosen candidate.
+    template <typename F>
+    void call(F f) {
+        if (candidates.empty()) {
+            throw logic_error("AdaptiveSelector: call() with no candidates");
+        }
+        uint64_t n = totalCalls++;
+        size_t chosen = best;
+        bool timed = false;
+        if (n % ProbeEvery == 0 || n < candidates.size()) {
+            // Probe (and, for the first calls, make sure every candidate gets measured once).
+            chosen = nextProbe;
+            nextProbe = (nextProbe + 1) % candidates.size();
+            timed = true;
+        } else if (n % SampleEvery == 0) {
+            timed = true;
+        }
+        Candidate& c = candidates[chosen];
+        c.calls++;
+        if (!timed) {
+            f(*c.strategy);
+            return;
+        }
+        auto start = chrono::steady_clock::now();
+        f(*c.strategy);
+        record(chosen, chrono::duration<double, nano>(chrono::steady_clock::now() - start).count());
+    }
+
+    const string& current() const { return candidates[best].name; }
+
+    void report() const {
+        for (const Candidate& c : candidates) {
+            cout << "    " << c.name << " | avg " << c.avgNs << " ns | " << c.calls << " calls"
+                 << (&c == &candidates[best] ? "  <- current" : "") << endl;
+        }
+    }
+
+    void resetCounts() {
+        for (Candidate& c : candidates) {
+            c.calls = 0;
+        }
+    }
+};
+
+// --- Adaptive strategies: look like any other strategy to a Robot ---
+class AdaptiveWalk : public WalkableRobot {
+public:
+    AdaptiveSelector<WalkableRobot> selector;
+
+    void walk() override {
+        selector.call([](WalkableRobot& w) { w.walk(); });
+    }
+};
+
+class AdaptiveTalk : public TalkableRobot {
+public:
+    AdaptiveSelector<TalkableRobot> selector;
+
+    void talk() override {
+        selector.call([](TalkableRobot& t) { t.talk(); });
+    }
+};
+
+class AdaptiveFly : public FlyableRobot {
+public:
+    AdaptiveSelector<FlyableRobot> selector;
+
+    void fly() override {
+        selector.call([](FlyableRobot& f) { f.fly(); });
+    }
+};
+
+// --- Concrete strategies ---
+// Walking cost depends on the terrain. `work` burns about one nanosecond per unit.
+struct Terrain {
+    bool rough = false;
+};
+
+static Terrain terrain;
+
+static void work(int units) {
+    uint64_t x = 1;
+    for (int i = 0; i < units; i++) {
+        x = x * 6364136223846793005ULL + 1442695040888963407ULL;
+        asm volatile("" : "+r"(x));
+    }
+}
+
+// Fast on flat ground, very slow on rough ground.
+class RollWalk : public WalkableRobot {
+public:
+    void walk() override { work(terrain.rough ? 1200 : 60); }
+};
+
+// Middle of the road on both.
+class StepWalk : public WalkableRobot {
+public:
+    void walk() override { work(terrain.rough ? 800 : 150); }
+};
+
+// Slow but the same everywhere.
+class CrawlWalk : public WalkableRobot {
+public:
+    void walk() override { work(300); }
+};
+
+class NormalTalk : public TalkableRobot {
+public:
+    void talk() override {
+        cout << "Talking normally..." << endl;
+    }
+};
+
+class NoFly : public FlyableRobot {
+public:
+    void fly() override {
+        cout << "Cannot fly." << endl;
+    }
+};
+
+// --- Robot Base Class ---
+class Robot {
+protected:
+    WalkableRobot* walkBehavior;
+    TalkableRobot* talkBehavior;
+    FlyableRobot* flyBehavior;
+
+public:
+    Robot(WalkableRobot* w, TalkableRobot* t, FlyableRobot* f) {
+        this->walkBehavior = w;
+        this->talkBehavior = t;
+        this->flyBehavior = f;
+    }
+
+    void walk() {
+        walkBehavior->walk();
+    }
+    void talk() {
+        talkBehavior->talk();
+    }
+    void fly() {
+        flyBehavior->fly();
+    }
+
+    virtual void projection() = 0; // Abstract method for subclasses
+};
+
+class CompanionRobot : public Robot {
+public:
+    CompanionRobot(WalkableRobot* w, TalkableRobot* t, FlyableRobot* f)
+        : Robot(w, t, f) {}
+
+    void projection() override {
+        cout << "Displaying friendly companion features..." << endl;
+    }
+};
+
+static AdaptiveWalk* makeAdaptiveWalk() {
+    AdaptiveWalk* walk = new AdaptiveWalk();
+    walk->selector.add("RollWalk ", new RollWalk());
+    walk->selector.add("StepWalk ", new StepWalk());
+    walk->selector.add("CrawlWalk", new CrawlWalk());
+    return walk;
+}
+
+// Runs `calls` walks, switching the terrain to rough halfway. Returns ns per call per half.
+static pair<double, double> run(Robot& robot, int calls) {
+    terrain.rough = false;
+    double halves[2];
+    for (int h = 0; h < 2; h++) {
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < calls / 2; i++) {
+            robot.walk();
+        }
+        halves[h] = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / (calls / 2);
+        terrain.rough = true;
+    }
+    return {halves[0], halves[1]};
+}
+
+// --- Main Function ---
+int main() {
+    AdaptiveWalk* demoWalk = makeAdaptiveWalk();
+    Robot* robot1 = new CompanionRobot(demoWalk, new NormalTalk(), new NoFly());
+    for (int i = 0; i < 10000; i++) {
+        robot1->walk();
+    }
+    robot1->talk();
+    robot1->fly();
+    robot1->projection();
+    cout << "Adaptive walk settled on " << demoWalk->selector.current() << " on flat ground" << endl;
+
+    // A selector with nothing to choose from is a setup bug, not a silent crash.
+    try {
+        AdaptiveWalk empty;
+        empty.walk();
+        cout << "Empty selector: FAILED, no exception" << endl;
+        return 1;
+    } catch (const logic_error& e) {
+        cout << "Empty selector: " << e.what() << endl;
+    }
+
+    const int calls = 1000000;
+    cout << "\n" << calls << " walk() calls, terrain flat for the first half and rough for the second:" << endl;
+
+    struct Option {
+        string label;
+        WalkableRobot* walk;
+    };
+    AdaptiveWalk* adaptive = makeAdaptiveWalk();
+    vector<Option> options = {
+        {"fixed RollWalk ", new RollWalk()},
+        {"fixed StepWalk ", new StepWalk()},
+        {"fixed CrawlWalk", new CrawlWalk()},
+        {"adaptive       ", adaptive},
+    };
+    for (Option& o : options) {
+        CompanionRobot robot(o.walk, new NormalTalk(), new NoFly());
+        if (o.walk == adaptive) {
+            adaptive->selector.resetCounts();
+        }
+        pair<double, double> ns = run(robot, calls);
+        cout << "  " << o.label << " | flat " << ns.first << " ns/call | rough " << ns.second
+             << " ns/call | overall " << (ns.first + ns.second) / 2 << " ns/call" << endl;
+    }
+    cout << "  adaptive selector at the end of the run:" << endl;
+    adaptive->selector.report();
+
+    return 0;
+}
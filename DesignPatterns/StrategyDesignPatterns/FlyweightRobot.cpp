@@ -0,0 +1,456 @@
+/*
+ * Flyweight Strategies Example
+ * ----------------------------
+ * main.cpp gives every robot its own `new NormalWalk()`, `new NoFly()`, ... and never frees
+ * them. Most strategies have no state at all, so a fleet of a million robots pays for three
+ * million identical heap objects (plus malloc overhead on each) that all do the same thing.
+ *
+ * Here ownership is explicit and nothing leaks:
+ *   - Stateless strategies are flyweights: one shared instance per type (flyweight<T>()).
+ *   - Stateful strategies (PatrolWalk remembers its waypoint, BatteryFly its charge) come from
+ *     StrategyPool<T>, a slab allocator with a free list, so they are packed together instead
+ *     of being scattered across the heap. Pooled<T> gives them a class operator new/delete
+ *     backed by that pool, so `new PatrolWalk(4)` and `delete` use it too.
+ *   - A Robot holds each strategy in a StrategyPtr, a unique_ptr whose deleter calls
+ *     release(). By default release() deletes the strategy, so a plain `new NormalWalk()` is
+ *     freed and a `new PatrolWalk(4)` goes back to its pool; flyweights ignore it. The robot
+ *     does not need to know which kind it has.
+ *
+ * main() runs the demo, then builds 1M robots the main.cpp way and the flyweight/pool way and
+ * reports heap bytes in use (glibc mallinfo2) and construction time for each.
+ *
+ * Build: g++ -std=c++17 -O2 FlyweightRobot.cpp
+ */
+#include <chrono>
+#include <iostream>
+#include <malloc.h>
+#include <memory>
+#include <new>
+#include <random>
+#include <utility>
+#include <vector>
+using namespace std;
+
+// --- Ownership ---
+class Behavior {
+public:
+    virtual ~Behavior() {}
+
+    // Called when a robot lets go of this strategy. Deleting it also covers pooled
+    // strategies (their operator delete returns the block); flyweights override this.
+    virtual void release() { delete this; }
+};
+
+struct ReleaseBehavior {
+    void operator()(Behavior* b) const { b->release(); }
+};
+
+template <typename I>
+using StrategyPtr = unique_ptr<I, ReleaseBehavior>;
+
+// The shared instance of a stateless strategy: never deleted, so release() does nothing.
+template <typename T>
+class Flyweight final : public T {
+public:
+    void release() override {}
+};
+
+// One shared instance per stateless strategy type.
+template <typename T>
+T* flyweight() {
+    static Flyweight<T> instance;
+    return &instance;
+}
+
+// Slab allocator for one stateful strategy type: raw blocks of sizeof(T), handed out by
+// Pooled<T>::operator new. Not thread-safe; robots are built on one thread.
+template <typename T>
+class StrategyPool {
+private:
+    union Block {
+        Block* next;
+        alignas(T) unsigned char storage[sizeof(T)];
+    };
+
+    static const size_t SlabSize = 4096;
+
+    vector<Block*> slabs;
+    Block* freeList = nullptr;
+    size_t inUse = 0;
+
+    StrategyPool() {}
+
+    void grow() {
+        Block* slab = static_cast<Block*>(::operator new(sizeof(Block) * SlabSize));
+        slabs.push_back(slab);
+        for (size_t i = 0; i < SlabSize; i++) {
+            slab[i].next = freeList;
+            freeList = &slab[i];
+        }
+    }
+
+public:
+    StrategyPool(const StrategyPool&) = delete;
+    StrategyPool& operator=(const StrategyPool&) = delete;
+
+    static StrategyPool& instance() {
+        static StrategyPool pool;
+        return pool;
+    }
+
+    // Every strategy must have been released before the pool goes away.
+    ~StrategyPool() {
+        for (Block* slab : slabs) {
+            ::operator delete(slab);
+        }
+    }
+
+    void* allocate() {
+        if (freeList == nullptr) {
+            grow();
+        }
+        Block* block = freeList;
+        freeList = block->next;
+        inUse++;
+        return block->storage;
+    }
+
+    void deallocate(void* p) {
+        Block* block = static_cast<Block*>(p);
+        block->next = freeList;
+        freeList = block;
+        inUse--;
+    }
+
+    size_t size() const { return inUse; }
+};
+
+// Base for stateful strategies: every `new Self(...)` takes a block from StrategyPool<Self>
+// and every delete (including the default release()) gives it back. A class derived from
+// Self has a different size and falls back to the global heap.
+template <typename Self, typename Interface>
+class Pooled : public Interface {
+public:
+    static void* operator new(size_t size) {
+        if (size != sizeof(Self)) {
+            return ::operator new(size);
+        }
+        return StrategyPool<Self>::instance().allocate();
+    }
+
+    static void operator delete(void* p, size_t size) {
+        if (size != sizeof(Self)) {
+            ::operator delete(p);
+            return;
+        }
+        StrategyPool<Self>::instance().deallocate(p);
+    }
+
+    template <typename... Args>
+    static StrategyPtr<Interface> create(Args&&... args) {
+        return StrategyPtr<Interface>(new Self(forward<Args>(args)...));
+    }
+};
+
+// --- Strategy Interface for Walk ---
+class WalkableRobot : public Behavior {
+public:
+    virtual void walk() = 0;
+};
+
+// --- Concrete Strategies for walk ---
+class NormalWalk : public WalkableRobot {
+public:
+    void walk() override {
+        cout << "Walking normally..." << endl;
+    }
+};
+
+class NoWalk : public WalkableRobot {
+public:
+    void walk() override {
+        cout << "Cannot walk." << endl;
+    }
+};
+
+// Stateful: every robot patrols its own route.
+class PatrolWalk : public Pooled<PatrolWalk, WalkableRobot> {
+private:
+    int waypoint = 0;
+    int waypoints;
+
+public:
+    PatrolWalk(int waypoints) : waypoints(waypoints) {}
+
+    void walk() override {
+        waypoint = (waypoint + 1) % waypoints;
+        cout << "Patrolling to waypoint " << waypoint << " of " << waypoints << "..." << endl;
+    }
+};
+
+// --- Strategy Interface for Talk ---
+class TalkableRobot : public Behavior {
+public:
+    virtual void talk() = 0;
+};
+
+// --- Concrete Strategies for Talk ---
+class NormalTalk : public TalkableRobot {
+public:
+    void talk() override {
+        cout << "Talking normally..." << endl;
+    }
+};
+
+class NoTalk : public TalkableRobot {
+public:
+    void talk() override {
+        cout << "Cannot talk." << endl;
+    }
+};
+
+// --- Strategy Interface for Fly ---
+class FlyableRobot : public Behavior {
+public:
+    virtual void fly() = 0;
+};
+
+class NormalFly : public FlyableRobot {
+public:
+    void fly() override {
+        cout << "Flying normally..." << endl;
+    }
+};
+
+class NoFly : public FlyableRobot {
+public:
+    void fly() override {
+        cout << "Cannot fly." << endl;
+    }
+};
+
+// Stateful: every robot drains its own battery.
+class BatteryFly : public Pooled<BatteryFly, FlyableRobot> {
+private:
+    int charge;
+
+public:
+    BatteryFly(int charge) : charge(charge) {}
+
+    void fly() override {
+        if (charge > 0) {
+            charge--;
+            cout << "Flying on battery, " << charge << " flights left..." << endl;
+        } else {
+            cout << "Battery empty, cannot fly." << endl;
+        }
+    }
+};
+
+// --- Robot Base Class ---
+class Robot {
+protected:
+    StrategyPtr<WalkableRobot> walkBehavior;
+    StrategyPtr<TalkableRobot> talkBehavior;
+    StrategyPtr<FlyableRobot> flyBehavior;
+
+public:
+    Robot(StrategyPtr<WalkableRobot> w, StrategyPtr<TalkableRobot> t, StrategyPtr<FlyableRobot> f)
+        : walkBehavior(move(w)), talkBehavior(move(t)), flyBehavior(move(f)) {}
+
+    virtual ~Robot() {}
+
+    void walk() {
+        walkBehavior->walk();
+    }
+    void talk() {
+        talkBehavior->talk();
+    }
+    void fly() {
+        flyBehavior->fly();
+    }
+
+    virtual void projection() = 0; // Abstract method for subclasses
+};
+
+// Wraps a flyweight in a StrategyPtr (release() is a no-op for it).
+template <typename I, typename T>
+StrategyPtr<I> shared() {
+    return StrategyPtr<I>(flyweight<T>());
+}
+
+// --- Concrete Robot Types ---
+class CompanionRobot : public Robot {
+public:
+    using Robot::Robot;
+
+    void projection() override {
+        cout << "Displaying friendly companion features..." << endl;
+    }
+};
+
+class WorkerRobot : public Robot {
+public:
+    using Robot::Robot;
+
+    void projection() override {
+        cout << "Displaying worker efficiency stats..." << endl;
+    }
+};
+
+// --- The main.cpp way, for comparison: raw owning pointers, never freed by the robot ---
+class LegacyRobot {
+protected:
+    Behavior* walkBehavior;
+    Behavior* talkBehavior;
+    Behavior* flyBehavior;
+
+public:
+    LegacyRobot(Behavior* w, Behavior* t, Behavior* f) : walkBehavior(w), talkBehavior(t), flyBehavior(f) {}
+    virtual ~LegacyRobot() {}
+
+    // Only so the benchmark can clean up after measuring; main.cpp leaks these.
+    void freeStrategies() {
+        delete walkBehavior;
+        delete talkBehavior;
+        delete flyBehavior;
+    }
+};
+
+class LegacyCompanionRobot : public LegacyRobot {
+public:
+    using LegacyRobot::LegacyRobot;
+};
+
+// Counts live instances, to show that a plain `new` strategy is freed with its robot.
+class CountedTalk : public NormalTalk {
+public:
+    static int alive;
+
+    CountedTalk() { alive++; }
+    ~CountedTalk() { alive--; }
+};
+
+int CountedTalk::alive = 0;
+
+static size_t heapInUse() {
+    return mallinfo2().uordblks;
+}
+
+// --- Main Function ---
+int main() {
+    Robot* robot1 = new CompanionRobot(shared<WalkableRobot, NormalWalk>(), shared<TalkableRobot, NormalTalk>(),
+                                       shared<FlyableRobot, NoFly>());
+    robot1->walk();
+    robot1->talk();
+    robot1->fly();
+    robot1->projection();
+
+    cout << "--------------------" << endl;
+
+    Robot* robot2 = new WorkerRobot(PatrolWalk::create(3), shared<TalkableRobot, NoTalk>(), BatteryFly::create(1));
+    robot2->walk();
+    robot2->walk();
+    robot2->talk();
+    robot2->fly();
+    robot2->fly();
+    robot2->projection();
+
+    delete robot1;
+    delete robot2;
+    cout << "Pooled strategies still in use: "
+         << StrategyPool<PatrolWalk>::instance().size() + StrategyPool<BatteryFly>::instance().size() << endl;
+
+    // Strategies made with plain `new` are freed by the default release(); a pooled one made
+    // with plain `new` still comes from and returns to its pool.
+    {
+        Robot* robot3 = new CompanionRobot(StrategyPtr<WalkableRobot>(new PatrolWalk(2)),
+                                           StrategyPtr<TalkableRobot>(new CountedTalk()),
+                                           StrategyPtr<FlyableRobot>(new NormalFly()));
+        int aliveWithRobot = CountedTalk::alive;
+        size_t pooledWithRobot = StrategyPool<PatrolWalk>::instance().size();
+        delete robot3;
+        size_t pooledAfter = StrategyPool<PatrolWalk>::instance().size();
+        cout << "`new` strategies alive: " << aliveWithRobot << " with the robot, " << CountedTalk::alive
+             << " after deleting it" << endl;
+        cout << "`new PatrolWalk` in its pool: " << pooledWithRobot << " with the robot, " << pooledAfter
+             << " after deleting it" << endl;
+        if (CountedTalk::alive != 0 || pooledWithRobot != 1 || pooledAfter != 0) {
+            return 1;
+        }
+    }
+
+    // 1M robots, a quarter with a stateful walk and a quarter with a stateful fly.
+    // Kind 0 = Normal*, 1 = No*, 2 = the stateful one.
+    const int robots = 1000000;
+    mt19937 rng(11);
+    vector<int> walkKind(robots), talkKind(robots), flyKind(robots);
+    for (int i = 0; i < robots; i++) {
+        int w = int(rng() % 4), f = int(rng() % 4);
+        walkKind[i] = w == 3 ? 2 : w % 2;
+        talkKind[i] = int(rng() % 2);
+        flyKind[i] = f == 3 ? 2 : f % 2;
+    }
+    cout << "\n" << robots << " robots:" << endl;
+
+    // The main.cpp way: one `new` per strategy. PatrolWalk and BatteryFly still land in their
+    // pools (Pooled owns their operator new), so only the stateless ones hit malloc here.
+    {
+        int stateful = 0;
+        for (int i = 0; i < robots; i++) {
+            stateful += (walkKind[i] == 2) + (flyKind[i] == 2);
+        }
+        vector<LegacyRobot*> fleet;
+        fleet.reserve(robots);
+        size_t heapBefore = heapInUse();
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < robots; i++) {
+            Behavior* w = walkKind[i] == 0 ? static_cast<Behavior*>(new NormalWalk())
+                        : walkKind[i] == 1 ? static_cast<Behavior*>(new NoWalk())
+                                           : static_cast<Behavior*>(new PatrolWalk(4));
+            Behavior* t = talkKind[i] == 0 ? static_cast<Behavior*>(new NormalTalk()) : new NoTalk();
+            Behavior* f = flyKind[i] == 0 ? static_cast<Behavior*>(new NormalFly())
+                        : flyKind[i] == 1 ? static_cast<Behavior*>(new NoFly())
+                                          : static_cast<Behavior*>(new BatteryFly(100));
+            fleet.push_back(new LegacyCompanionRobot(w, t, f));
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        size_t bytes = heapInUse() - heapBefore;
+        cout << "  new per strategy    | " << ms << " ms | " << bytes / 1048576.0 << " MiB heap | "
+             << robots * 4 - stateful << " allocations, " << stateful << " pooled strategies" << endl;
+        for (LegacyRobot* r : fleet) {
+            r->freeStrategies();
+            delete r;
+        }
+    }
+
+    {
+        vector<Robot*> fleet;
+        fleet.reserve(robots);
+        size_t heapBefore = heapInUse();
+        auto start = chrono::steady_clock::now();
+        for (int i = 0; i < robots; i++) {
+            StrategyPtr<WalkableRobot> w = walkKind[i] == 0 ? shared<WalkableRobot, NormalWalk>()
+                                         : walkKind[i] == 1 ? shared<WalkableRobot, NoWalk>()
+                                                            : PatrolWalk::create(4);
+            StrategyPtr<TalkableRobot> t = talkKind[i] == 0 ? shared<TalkableRobot, NormalTalk>()
+                                                            : shared<TalkableRobot, NoTalk>();
+            StrategyPtr<FlyableRobot> f = flyKind[i] == 0 ? shared<FlyableRobot, NormalFly>()
+                                        : flyKind[i] == 1 ? shared<FlyableRobot, NoFly>()
+                                                          : BatteryFly::create(100);
+            fleet.push_back(new CompanionRobot(move(w), move(t), move(f)));
+        }
+        double ms = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        size_t bytes = heapInUse() - heapBefore;
+        size_t pooled = StrategyPool<PatrolWalk>::instance().size() + StrategyPool<BatteryFly>::instance().size();
+        cout << "  flyweight + pool    | " << ms << " ms | " << bytes / 1048576.0 << " MiB heap | "
+             << robots << " robot allocations, " << pooled << " pooled strategies" << endl;
+        for (Robot* r : fleet) {
+            delete r;
+        }
+        cout << "  after deleting the fleet, pooled strategies in use: "
+             << StrategyPool<PatrolWalk>::instance().size() + StrategyPool<BatteryFly>::instance().size() << endl;
+    }
+
+    return 0;
+}
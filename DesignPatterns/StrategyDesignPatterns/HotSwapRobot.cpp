@@ -0,0 +1,424 @@
+/*
+ * Hot-Swappable Strategy Example
+ * ------------------------------
+ * In main.cpp a Robot's behaviors are plain pointers fixed at construction. Replacing
+ * `walkBehavior` while another thread is inside `walk()` is a data race, and deleting the old
+ * strategy could free it while it is still running.
+ *
+ * HotSwapRobot lets a fleet controller change behaviors live, with no lock on the call path:
+ *   - Each behavior is an atomic pointer. walk()/talk()/fly() enter a read-side critical
+ *     section, load the pointer and call through it.
+ *   - setWalk()/setTalk()/setFly() swap in the new strategy (RCU-style publication) and retire
+ *     the old one. Writers serialize on a mutex that callers never touch.
+ *   - Retired strategies are freed by epoch-based reclamation: a caller publishes the global
+ *     epoch in its own cache-line slot while inside a call, and a strategy retired in epoch R
+ *     is deleted once no slot holds an epoch <= R.
+ *
+ * Strategies must be safe to call from several threads at once, so here they return their
+ * contribution instead of mutating the robot.
+ *
+ * main() runs the demo, a stress test (callers and swappers hammering the same robot while
+ * every strategy checks it has not been freed), and a benchmark of call throughput with and
+ * without a controller swapping behaviors continuously.
+ *
+ * Build: g++ -std=c++17 -O2 -pthread HotSwapRobot.cpp
+ */
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+using namespace std;
+
+// Epoch-based reclamation, the same scheme as ObserverDesignPattern/CopyOnWriteChannel.cpp
+// (change both together). Every thread that calls into a HotSwapRobot gets a slot holding the
+// epoch it entered in; a retired strategy is freed once no slot is at or below its epoch.
+class EpochDomain {
+public:
+    static const int MaxThreads = 256;
+
+private:
+    struct alignas(64) ReaderSlot {
+        atomic<uint64_t> epoch{0};   // 0 = not inside walk()/talk()/fly()
+        atomic<bool> owned{false};
+    };
+
+    ReaderSlot slots[MaxThreads];
+    atomic<uint64_t> globalEpoch{1};
+
+    // A calling thread's slot, claimed on its first call and freed when it exits.
+    struct ThreadState {
+        EpochDomain* domain = nullptr;
+        int slot = -1;
+        int depth = 0;
+
+        ~ThreadState() {
+            if (domain && slot >= 0) {
+                domain->slots[slot].owned.store(false, memory_order_release);
+            }
+        }
+    };
+
+    ThreadState& threadState() {
+        thread_local ThreadState state;
+        if (state.slot < 0) {
+            for (int i = 0; i < MaxThreads; i++) {
+                bool expected = false;
+                if (slots[i].owned.compare_exchange_strong(expected, true)) {
+                    state.domain = this;
+                    state.slot = i;
+                    break;
+                }
+            }
+            if (state.slot < 0) {
+                cerr << "EpochDomain: more than " << MaxThreads << " reader threads" << endl;
+                terminate();
+            }
+        }
+        return state;
+    }
+
+public:
+    static EpochDomain& instance() {
+        static EpochDomain domain;
+        return domain;
+    }
+
+    // Read-side critical sections may nest (a strategy that calls another robot).
+    void enter() {
+        ThreadState& state = threadState();
+        if (state.depth++ == 0) {
+            slots[state.slot].epoch.store(globalEpoch.load(memory_order_relaxed), memory_order_seq_cst);
+        }
+    }
+
+    void exit() {
+        ThreadState& state = threadState();
+        if (--state.depth == 0) {
+            slots[state.slot].epoch.store(0, memory_order_release);
+        }
+    }
+
+    // Called by setWalk()/setTalk()/setFly() after swapping out a strategy.
+    uint64_t retireEpoch() {
+        return globalEpoch.fetch_add(1, memory_order_seq_cst);
+    }
+
+    // True once no call can still be running inside a strategy retired in `epoch`.
+    bool isSafe(uint64_t epoch) const {
+        for (int i = 0; i < MaxThreads; i++) {
+            uint64_t e = slots[i].epoch.load(memory_order_seq_cst);
+            if (e != 0 && e <= epoch) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
+
+// Held for the duration of one walk()/talk()/fly() call.
+class ReadGuard {
+public:
+    ReadGuard() { EpochDomain::instance().enter(); }
+    ~ReadGuard() { EpochDomain::instance().exit(); }
+};
+
+// --- Strategy interfaces ---
+// `alive` is cleared by the destructor so the stress test can detect a call into a freed strategy.
+class Behavior {
+public:
+    static const uint32_t AliveMagic = 0xB0B0CAFE;
+    static atomic<long> liveCount;
+
+    atomic<uint32_t> alive{AliveMagic};
+
+    Behavior() { liveCount.fetch_add(1, memory_order_relaxed); }
+    virtual ~Behavior() {
+        alive.store(0, memory_order_relaxed);
+        liveCount.fetch_sub(1, memory_order_relaxed);
+    }
+
+    bool isAlive() const { return alive.load(memory_order_relaxed) == AliveMagic; }
+};
+
+atomic<long> Behavior::liveCount{0};
+
+class WalkableRobot : public Behavior {
+public:
+    virtual int walk() const = 0;   // returns distance covered
+    virtual string name() const = 0;
+};
+
+class TalkableRobot : public Behavior {
+public:
+    virtual int talk() const = 0;   // returns words spoken
+    virtual string name() const = 0;
+};
+
+class FlyableRobot : public Behavior {
+public:
+    virtual int fly() const = 0;    // returns altitude gained
+    virtual string name() const = 0;
+};
+
+// --- Concrete strategies ---
+class NormalWalk : public WalkableRobot {
+public:
+    int walk() const override { return 1; }
+    string name() const override { return "Walking normally"; }
+};
+
+class FastWalk : public WalkableRobot {
+public:
+    int walk() const override { return 3; }
+    string name() const override { return "Walking fast"; }
+};
+
+class NoWalk : public WalkableRobot {
+public:
+    int walk() const override { return 0; }
+    string name() const override { return "Cannot walk"; }
+};
+
+class NormalTalk : public TalkableRobot {
+public:
+    int talk() const override { return 3; }
+    string name() const override { return "Talking normally"; }
+};
+
+class NoTalk : public TalkableRobot {
+public:
+    int talk() const override { return 0; }
+    string name() const override { return "Cannot talk"; }
+};
+
+class NormalFly : public FlyableRobot {
+public:
+    int fly() const override { return 10; }
+    string name() const override { return "Flying normally"; }
+};
+
+class NoFly : public FlyableRobot {
+public:
+    int fly() const override { return 0; }
+    string name() const override { return "Cannot fly"; }
+};
+
+// --- Robot whose behaviors can be replaced while other threads call them ---
+class HotSwapRobot {
+private:
+    struct Retired {
+        Behavior* behavior;
+        uint64_t epoch;
+    };
+
+    atomic<WalkableRobot*> walkBehavior;
+    atomic<TalkableRobot*> talkBehavior;
+    atomic<FlyableRobot*> flyBehavior;
+    mutex writerMtx;            // serializes swaps only, never taken by walk()/talk()/fly()
+    vector<Retired> retired;    // guarded by writerMtx
+
+    // Must hold writerMtx.
+    void retire(Behavior* old) {
+        retired.push_back({old, EpochDomain::instance().retireEpoch()});
+        reclaim();
+    }
+
+    // Must hold writerMtx.
+    void reclaim() {
+        EpochDomain& domain = EpochDomain::instance();
+        size_t kept = 0;
+        for (auto& r : retired) {
+            if (domain.isSafe(r.epoch)) {
+                delete r.behavior;
+            } else {
+                retired[kept++] = r;
+            }
+        }
+        retired.resize(kept);
+    }
+
+public:
+    // Takes ownership of the strategies.
+    HotSwapRobot(WalkableRobot* w, TalkableRobot* t, FlyableRobot* f)
+        : walkBehavior(w), talkBehavior(t), flyBehavior(f) {}
+
+    // No thread may still be calling into the robot when it is destroyed.
+    ~HotSwapRobot() {
+        for (auto& r : retired) {
+            delete r.behavior;
+        }
+        delete walkBehavior.load();
+        delete talkBehavior.load();
+        delete flyBehavior.load();
+    }
+
+    int walk() {
+        ReadGuard guard;
+        return walkBehavior.load(memory_order_seq_cst)->walk();
+    }
+
+    int talk() {
+        ReadGuard guard;
+        return talkBehavior.load(memory_order_seq_cst)->talk();
+    }
+
+    int fly() {
+        ReadGuard guard;
+        return flyBehavior.load(memory_order_seq_cst)->fly();
+    }
+
+    // Takes ownership of `w`; the previous strategy is freed once no caller can still use it.
+    void setWalk(WalkableRobot* w) {
+        lock_guard<mutex> lock(writerMtx);
+        retire(walkBehavior.exchange(w, memory_order_seq_cst));
+    }
+
+    void setTalk(TalkableRobot* t) {
+        lock_guard<mutex> lock(writerMtx);
+        retire(talkBehavior.exchange(t, memory_order_seq_cst));
+    }
+
+    void setFly(FlyableRobot* f) {
+        lock_guard<mutex> lock(writerMtx);
+        retire(flyBehavior.exchange(f, memory_order_seq_cst));
+    }
+
+    void describe() {
+        ReadGuard guard;
+        cout << walkBehavior.load()->name() << ", " << talkBehavior.load()->name() << ", "
+             << flyBehavior.load()->name() << endl;
+    }
+
+    // For the stress test: calls each strategy and checks it has not been freed.
+    bool callAndCheck(long& sum) {
+        ReadGuard guard;
+        WalkableRobot* w = walkBehavior.load(memory_order_seq_cst);
+        TalkableRobot* t = talkBehavior.load(memory_order_seq_cst);
+        FlyableRobot* f = flyBehavior.load(memory_order_seq_cst);
+        sum += w->walk() + t->talk() + f->fly();
+        return w->isAlive() && t->isAlive() && f->isAlive();
+    }
+
+    size_t pendingReclaim() {
+        lock_guard<mutex> lock(writerMtx);
+        reclaim();
+        return retired.size();
+    }
+};
+
+// Runs `callers` threads calling the robot and, if `swapping`, one controller thread swapping
+// its walk/fly strategies back and forth every `swapEvery` until `duration` is up.
+static void runLoad(const string& label, HotSwapRobot& robot, int callers, bool swapping,
+                    chrono::microseconds swapEvery, chrono::milliseconds duration) {
+    atomic<bool> stop{false};
+    atomic<long> calls{0};
+    long swaps = 0;
+    vector<thread> threads;
+    for (int t = 0; t < callers; t++) {
+        threads.emplace_back([&] {
+            long n = 0, sum = 0;
+            while (!stop.load(memory_order_relaxed)) {
+                sum += robot.walk() + robot.talk() + robot.fly();
+                n += 3;
+            }
+            calls.fetch_add(n);
+            asm volatile("" : : "r"(sum));
+        });
+    }
+    thread controller;
+    if (swapping) {
+        controller = thread([&] {
+            while (!stop.load(memory_order_relaxed)) {
+                if (swaps & 1) {
+                    robot.setWalk(new NormalWalk());
+                    robot.setFly(new NoFly());
+                } else {
+                    robot.setWalk(new FastWalk());
+                    robot.setFly(new NormalFly());
+                }
+                swaps++;
+                this_thread::sleep_for(swapEvery);
+            }
+        });
+    }
+    this_thread::sleep_for(duration);
+    stop.store(true);
+    for (auto& th : threads) {
+        th.join();
+    }
+    if (controller.joinable()) {
+        controller.join();
+    }
+    double secs = chrono::duration<double>(duration).count();
+    cout << "  " << label << " | " << calls.load() / secs / 1e6 << " M calls/s | strategy swaps/s "
+         << long(swaps * 2 / secs) << endl;
+}
+
+// --- Main Function ---
+int main() {
+    HotSwapRobot robot(new NormalWalk(), new NormalTalk(), new NoFly());
+    robot.describe();
+    robot.setWalk(new NoWalk());
+    robot.setFly(new NormalFly());
+    cout << "After hot swap: ";
+    robot.describe();
+
+    // Stress: readers call and verify every strategy they use is still alive while swappers
+    // replace all three behaviors as fast as they can.
+    {
+        const int readers = 8;
+        const int swappers = 2;
+        HotSwapRobot target(new NormalWalk(), new NormalTalk(), new NormalFly());
+        atomic<bool> stop{false};
+        atomic<long> calls{0}, violations{0}, swaps{0};
+        vector<thread> threads;
+        for (int t = 0; t < readers; t++) {
+            threads.emplace_back([&] {
+                long n = 0, bad = 0, sum = 0;
+                while (!stop.load(memory_order_relaxed)) {
+                    bad += !target.callAndCheck(sum);
+                    n++;
+                }
+                calls.fetch_add(n);
+                violations.fetch_add(bad);
+            });
+        }
+        for (int t = 0; t < swappers; t++) {
+            threads.emplace_back([&, t] {
+                long n = 0;
+                while (!stop.load(memory_order_relaxed)) {
+                    bool flip = (n + t) & 1;
+                    target.setWalk(flip ? static_cast<WalkableRobot*>(new FastWalk()) : new NormalWalk());
+                    target.setTalk(flip ? static_cast<TalkableRobot*>(new NoTalk()) : new NormalTalk());
+                    target.setFly(flip ? static_cast<FlyableRobot*>(new NoFly()) : new NormalFly());
+                    n += 3;
+                    if ((n & 63) == 0) {
+                        this_thread::yield();
+                    }
+                }
+                swaps.fetch_add(n);
+            });
+        }
+        this_thread::sleep_for(chrono::milliseconds(1000));
+        stop.store(true);
+        for (auto& th : threads) {
+            th.join();
+        }
+        cout << "\nStress: " << readers << " callers + " << swappers << " swappers for 1s: " << calls.load()
+             << " calls, " << swaps.load() << " swaps, " << violations.load() << " calls into freed strategies, "
+             << target.pendingReclaim() << " retired strategies still pending" << endl;
+    }
+    cout << "Strategies still alive: " << Behavior::liveCount.load() << " (the demo robot's 3)" << endl;
+
+    const int callers = 4;
+    const auto duration = chrono::milliseconds(1000);
+    cout << "\n" << callers << " caller threads:" << endl;
+    HotSwapRobot steady(new NormalWalk(), new NormalTalk(), new NoFly());
+    runLoad("no swaps                ", steady, callers, false, chrono::microseconds(0), duration);
+    runLoad("swapping every 50us     ", steady, callers, true, chrono::microseconds(50), duration);
+
+    return 0;
+}
@@ -0,0 +1,280 @@
+/*
+ * Compile-time Strategy (Policy-Based Design) Example
+ * ---------------------------------------------------
+ * main.cpp composes a Robot from three heap-allocated strategy objects and calls them through
+ * virtual functions. That keeps behaviors swappable at runtime, but every walk()/talk()/fly()
+ * is a pointer chase plus an indirect call the compiler cannot inline.
+ *
+ * When a robot's behaviors are fixed for its whole life, the same composition can be done at
+ * compile time: Robot<Walk, Talk, Fly> inherits its behaviors as policies, so they live inline
+ * in the robot (empty ones take no space) and every call is resolved statically and inlined.
+ * The runtime-swappable Robot in main.cpp is still the right tool when behaviors must change
+ * while the robot is alive.
+ *
+ * The behaviors below update a RobotState instead of printing, so they can be benchmarked.
+ * The same behavior structs are used three ways:
+ *   - VirtualRobot: owns strategy objects behind base-class pointers (as in main.cpp).
+ *   - VariantRobot: stores each behavior in a std::variant and dispatches with std::visit.
+ *   - Robot<Walk, Talk, Fly>: the policy template; a fleet keeps one vector per robot type.
+ *
+ * main() builds the same mixed fleet in all three forms and times 100M behavior calls.
+ *
+ * Build: g++ -std=c++17 -O2 PolicyRobot.cpp
+ */
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <tuple>
+#include <variant>
+#include <vector>
+using namespace std;
+
+struct RobotState {
+    long distance = 0;
+    long words = 0;
+    long altitude = 0;
+};
+
+// --- Behaviors (plain structs, no virtual functions) ---
+struct NormalWalk {
+    void walk(RobotState& s) { s.distance += 1; }
+};
+
+struct NoWalk {
+    void walk(RobotState&) {}
+};
+
+struct NormalTalk {
+    void talk(RobotState& s) { s.words += 3; }
+};
+
+struct NoTalk {
+    void talk(RobotState&) {}
+};
+
+struct NormalFly {
+    void fly(RobotState& s) { s.altitude += 10; }
+};
+
+struct NoFly {
+    void fly(RobotState&) {}
+};
+
+// --- Compile-time composition ---
+template <typename Walk, typename Talk, typename Fly>
+class Robot : private Walk, private Talk, private Fly {
+private:
+    RobotState state;
+
+public:
+    void walk() { Walk::walk(state); }
+    void talk() { Talk::talk(state); }
+    void fly() { Fly::fly(state); }
+
+    const RobotState& getState() const { return state; }
+
+    void projection() const {
+        cout << "distance " << state.distance << ", words " << state.words
+             << ", altitude " << state.altitude << endl;
+    }
+};
+
+using CompanionRobot = Robot<NormalWalk, NormalTalk, NoFly>;
+using WorkerRobot = Robot<NoWalk, NoTalk, NormalFly>;
+
+// --- Runtime composition through virtual calls (as in main.cpp) ---
+class WalkableRobot {
+public:
+    virtual void walk(RobotState& s) = 0;
+    virtual ~WalkableRobot() {}
+};
+
+class TalkableRobot {
+public:
+    virtual void talk(RobotState& s) = 0;
+    virtual ~TalkableRobot() {}
+};
+
+class FlyableRobot {
+public:
+    virtual void fly(RobotState& s) = 0;
+    virtual ~FlyableRobot() {}
+};
+
+template <typename B>
+class VirtualWalk : public WalkableRobot {
+    B behavior;
+public:
+    void walk(RobotState& s) override { behavior.walk(s); }
+};
+
+template <typename B>
+class VirtualTalk : public TalkableRobot {
+    B behavior;
+public:
+    void talk(RobotState& s) override { behavior.talk(s); }
+};
+
+template <typename B>
+class VirtualFly : public FlyableRobot {
+    B behavior;
+public:
+    void fly(RobotState& s) override { behavior.fly(s); }
+};
+
+class VirtualRobot {
+private:
+    unique_ptr<WalkableRobot> walkBehavior;
+    unique_ptr<TalkableRobot> talkBehavior;
+    unique_ptr<FlyableRobot> flyBehavior;
+    RobotState state;
+
+public:
+    VirtualRobot(WalkableRobot* w, TalkableRobot* t, FlyableRobot* f)
+        : walkBehavior(w), talkBehavior(t), flyBehavior(f) {}
+
+    void walk() { walkBehavior->walk(state); }
+    void talk() { talkBehavior->talk(state); }
+    void fly() { flyBehavior->fly(state); }
+
+    const RobotState& getState() const { return state; }
+};
+
+// --- Runtime composition through std::variant ---
+class VariantRobot {
+private:
+    variant<NormalWalk, NoWalk> walkBehavior;
+    variant<NormalTalk, NoTalk> talkBehavior;
+    variant<NormalFly, NoFly> flyBehavior;
+    RobotState state;
+
+public:
+    VariantRobot(variant<NormalWalk, NoWalk> w, variant<NormalTalk, NoTalk> t, variant<NormalFly, NoFly> f)
+        : walkBehavior(w), talkBehavior(t), flyBehavior(f) {}
+
+    void walk() { visit([this](auto& b) { b.walk(state); }, walkBehavior); }
+    void talk() { visit([this](auto& b) { b.talk(state); }, talkBehavior); }
+    void fly() { visit([this](auto& b) { b.fly(state); }, flyBehavior); }
+
+    const RobotState& getState() const { return state; }
+};
+
+// --- Fleet of statically typed robots: one contiguous vector per robot type ---
+template <typename... Robots>
+class StaticFleet {
+private:
+    tuple<vector<Robots>...> groups;
+
+public:
+    template <typename R>
+    void add() {
+        get<vector<R>>(groups).emplace_back();
+    }
+
+    template <typename F>
+    void forEach(F f) {
+        apply([&](auto&... group) { (forEachIn(group, f), ...); }, groups);
+    }
+
+private:
+    template <typename Group, typename F>
+    static void forEachIn(Group& group, F& f) {
+        for (auto& robot : group) {
+            f(robot);
+        }
+    }
+};
+
+// All eight walk/talk/fly combinations.
+using FleetOfAllKinds = StaticFleet<
+    Robot<NormalWalk, NormalTalk, NormalFly>, Robot<NormalWalk, NormalTalk, NoFly>,
+    Robot<NormalWalk, NoTalk, NormalFly>, Robot<NormalWalk, NoTalk, NoFly>,
+    Robot<NoWalk, NormalTalk, NormalFly>, Robot<NoWalk, NormalTalk, NoFly>,
+    Robot<NoWalk, NoTalk, NormalFly>, Robot<NoWalk, NoTalk, NoFly>>;
+
+// Adds robot kind `k` (bit 2 = walks, bit 1 = talks, bit 0 = flies) to each fleet.
+void addKind(int k, vector<VirtualRobot>& virt, vector<VariantRobot>& var, FleetOfAllKinds& fleet) {
+    bool w = k & 4, t = k & 2, f = k & 1;
+    virt.emplace_back(w ? static_cast<WalkableRobot*>(new VirtualWalk<NormalWalk>()) : new VirtualWalk<NoWalk>(),
+                      t ? static_cast<TalkableRobot*>(new VirtualTalk<NormalTalk>()) : new VirtualTalk<NoTalk>(),
+                      f ? static_cast<FlyableRobot*>(new VirtualFly<NormalFly>()) : new VirtualFly<NoFly>());
+    var.emplace_back(w ? variant<NormalWalk, NoWalk>(NormalWalk()) : NoWalk(),
+                     t ? variant<NormalTalk, NoTalk>(NormalTalk()) : NoTalk(),
+                     f ? variant<NormalFly, NoFly>(NormalFly()) : NoFly());
+    switch (k) {
+        case 7: fleet.add<Robot<NormalWalk, NormalTalk, NormalFly>>(); break;
+        case 6: fleet.add<Robot<NormalWalk, NormalTalk, NoFly>>(); break;
+        case 5: fleet.add<Robot<NormalWalk, NoTalk, NormalFly>>(); break;
+        case 4: fleet.add<Robot<NormalWalk, NoTalk, NoFly>>(); break;
+        case 3: fleet.add<Robot<NoWalk, NormalTalk, NormalFly>>(); break;
+        case 2: fleet.add<Robot<NoWalk, NormalTalk, NoFly>>(); break;
+        case 1: fleet.add<Robot<NoWalk, NoTalk, NormalFly>>(); break;
+        default: fleet.add<Robot<NoWalk, NoTalk, NoFly>>(); break;
+    }
+}
+
+template <typename ForEach>
+void bench(const string& label, long rounds, long calls, ForEach forEach) {
+    auto start = chrono::steady_clock::now();
+    for (long r = 0; r < rounds; r++) {
+        forEach([](auto& robot) {
+            robot.walk();
+            robot.talk();
+            robot.fly();
+        });
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long checksum = 0;
+    forEach([&](auto& robot) {
+        const RobotState& s = robot.getState();
+        checksum += s.distance + s.words + s.altitude;
+    });
+    cout << "  " << label << " | " << secs * 1e9 / calls << " ns per call | " << calls / secs / 1e6
+         << " M calls/s | checksum " << checksum << endl;
+}
+
+// --- Main Function ---
+int main() {
+    CompanionRobot robot1;
+    robot1.walk();
+    robot1.talk();
+    robot1.fly();
+    robot1.projection();
+
+    cout << "--------------------" << endl;
+
+    WorkerRobot robot2;
+    robot2.walk();
+    robot2.talk();
+    robot2.fly();
+    robot2.projection();
+
+    cout << "Companion robot size: " << sizeof(CompanionRobot) << " bytes (behaviors take no space)" << endl;
+
+    // A shuffled fleet so runtime dispatch sees a realistic mix of targets.
+    const int fleetSize = 4096;
+    const long totalCalls = 100000000;
+    const long rounds = totalCalls / (3L * fleetSize);
+    const long calls = rounds * 3L * fleetSize;
+
+    vector<VirtualRobot> virtualFleet;
+    vector<VariantRobot> variantFleet;
+    FleetOfAllKinds staticFleet;
+    mt19937 rng(42);
+    for (int i = 0; i < fleetSize; i++) {
+        addKind(int(rng() % 8), virtualFleet, variantFleet, staticFleet);
+    }
+
+    cout << "\n" << fleetSize << " robots, " << calls << " behavior calls:" << endl;
+    bench("virtual dispatch ", rounds, calls, [&](auto f) {
+        for (auto& robot : virtualFleet) f(robot);
+    });
+    bench("std::variant     ", rounds, calls, [&](auto f) {
+        for (auto& robot : variantFleet) f(robot);
+    });
+    bench("Robot<W, T, F>   ", rounds, calls, [&](auto f) { staticFleet.forEach(f); });
+
+    return 0;
+}
@@ -0,0 +1,355 @@
+/*
+ * Data-Oriented Robot Fleet Example
+ * ---------------------------------
+ * main.cpp builds each robot with `new CompanionRobot(new NormalWalk(), ...)`. For one robot
+ * that is fine. For a fleet of a million, a simulation tick walks a vector of Robot pointers,
+ * jumps to each Robot somewhere on the heap, then jumps again into each of its three strategy
+ * objects and makes a virtual call. Almost every step is a cache miss, and nothing can be
+ * vectorized.
+ *
+ * RobotFleet keeps the Strategy idea (behaviors are still chosen per robot when it is added),
+ * but stores the fleet as structure-of-arrays grouped by behavior combination:
+ *   - Robots with the same walk/talk/fly behaviors share a Group.
+ *   - A Group holds one contiguous array per field (distance, words, altitude, speed, battery).
+ *   - A tick picks each group's behavior once and runs it over the whole batch, a tight loop
+ *     over contiguous arrays that the compiler can vectorize.
+ *
+ * main() simulates 10M robot ticks (1M robots x 10 ticks) with the object graph and with the
+ * fleet, and reports ticks/sec plus hardware cache misses when the kernel allows perf counters.
+ *
+ * Build: g++ -std=c++17 -O2 RobotFleet.cpp
+ */
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+using namespace std;
+
+enum class Walk { Normal, None };
+enum class Talk { Normal, None };
+enum class Fly { Normal, None };
+
+// --- Data-oriented fleet ---
+class RobotFleet {
+public:
+    struct RobotId {
+        uint32_t group;
+        uint32_t index;
+    };
+
+private:
+    struct Group {
+        Walk walk;
+        Talk talk;
+        Fly fly;
+        vector<int32_t> distance, words, altitude, speed, battery;
+    };
+
+    Group groups[8];
+
+    static int groupOf(Walk w, Talk t, Fly f) {
+        return (w == Walk::Normal) * 4 + (t == Talk::Normal) * 2 + (f == Fly::Normal);
+    }
+
+    // --- Batched behaviors: one call per group, a plain loop inside ---
+    static void walkBatch(Group& g) {
+        if (g.walk == Walk::None) return;
+        size_t n = g.distance.size();
+        int32_t* distance = g.distance.data();
+        const int32_t* speed = g.speed.data();
+        int32_t* battery = g.battery.data();
+        for (size_t i = 0; i < n; i++) {
+            distance[i] += speed[i];
+            battery[i] -= 1;
+        }
+    }
+
+    static void talkBatch(Group& g) {
+        if (g.talk == Talk::None) return;
+        size_t n = g.words.size();
+        int32_t* words = g.words.data();
+        int32_t* battery = g.battery.data();
+        for (size_t i = 0; i < n; i++) {
+            words[i] += 3;
+            battery[i] -= 1;
+        }
+    }
+
+    static void flyBatch(Group& g) {
+        if (g.fly == Fly::None) return;
+        size_t n = g.altitude.size();
+        int32_t* altitude = g.altitude.data();
+        int32_t* battery = g.battery.data();
+        for (size_t i = 0; i < n; i++) {
+            altitude[i] += 10;
+            battery[i] -= 2;
+        }
+    }
+
+public:
+    RobotFleet() {
+        for (int k = 0; k < 8; k++) {
+            groups[k].walk = (k & 4) ? Walk::Normal : Walk::None;
+            groups[k].talk = (k & 2) ? Talk::Normal : Talk::None;
+            groups[k].fly = (k & 1) ? Fly::Normal : Fly::None;
+        }
+    }
+
+    RobotId add(Walk w, Talk t, Fly f, int32_t speed) {
+        int k = groupOf(w, t, f);
+        Group& g = groups[k];
+        g.distance.push_back(0);
+        g.words.push_back(0);
+        g.altitude.push_back(0);
+        g.speed.push_back(speed);
+        g.battery.push_back(1000000);
+        return RobotId{uint32_t(k), uint32_t(g.distance.size() - 1)};
+    }
+
+    void tick() {
+        for (Group& g : groups) {
+            walkBatch(g);
+            talkBatch(g);
+            flyBatch(g);
+        }
+    }
+
+    int64_t distanceOf(RobotId id) const { return groups[id.group].distance[id.index]; }
+    int64_t altitudeOf(RobotId id) const { return groups[id.group].altitude[id.index]; }
+
+    int64_t checksum() const {
+        int64_t sum = 0;
+        for (const Group& g : groups) {
+            for (size_t i = 0; i < g.distance.size(); i++) {
+                sum += g.distance[i] + g.words[i] + g.altitude[i] + g.battery[i];
+            }
+        }
+        return sum;
+    }
+};
+
+// --- Baseline: the object graph from main.cpp, with behaviors updating state ---
+struct RobotState {
+    int32_t distance = 0, words = 0, altitude = 0, speed = 0, battery = 1000000;
+};
+
+class WalkableRobot {
+public:
+    virtual void walk(RobotState& s) = 0;
+    virtual ~WalkableRobot() {}
+};
+
+class NormalWalk : public WalkableRobot {
+public:
+    void walk(RobotState& s) override { s.distance += s.speed; s.battery -= 1; }
+};
+
+class NoWalk : public WalkableRobot {
+public:
+    void walk(RobotState&) override {}
+};
+
+class TalkableRobot {
+public:
+    virtual void talk(RobotState& s) = 0;
+    virtual ~TalkableRobot() {}
+};
+
+class NormalTalk : public TalkableRobot {
+public:
+    void talk(RobotState& s) override { s.words += 3; s.battery -= 1; }
+};
+
+class NoTalk : public TalkableRobot {
+public:
+    void talk(RobotState&) override {}
+};
+
+class FlyableRobot {
+public:
+    virtual void fly(RobotState& s) = 0;
+    virtual ~FlyableRobot() {}
+};
+
+class NormalFly : public FlyableRobot {
+public:
+    void fly(RobotState& s) override { s.altitude += 10; s.battery -= 2; }
+};
+
+class NoFly : public FlyableRobot {
+public:
+    void fly(RobotState&) override {}
+};
+
+class Robot {
+protected:
+    WalkableRobot* walkBehavior;
+    TalkableRobot* talkBehavior;
+    FlyableRobot* flyBehavior;
+
+public:
+    RobotState state;
+
+    Robot(WalkableRobot* w, TalkableRobot* t, FlyableRobot* f) {
+        this->walkBehavior = w;
+        this->talkBehavior = t;
+        this->flyBehavior = f;
+    }
+
+    virtual ~Robot() {
+        delete walkBehavior;
+        delete talkBehavior;
+        delete flyBehavior;
+    }
+
+    void walk() { walkBehavior->walk(state); }
+    void talk() { talkBehavior->talk(state); }
+    void fly() { flyBehavior->fly(state); }
+};
+
+// --- Hardware cache-miss counter (Linux perf_event_open; reports n/a when not permitted) ---
+class CacheMissCounter {
+private:
+    int fd = -1;
+
+public:
+    CacheMissCounter() {
+#ifdef __linux__
+        perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = PERF_COUNT_HW_CACHE_MISSES;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd = int(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#endif
+    }
+
+    ~CacheMissCounter() {
+#ifdef __linux__
+        if (fd >= 0) close(fd);
+#endif
+    }
+
+    void start() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    // Misses since start(), or -1 when counters are unavailable.
+    long long stop() {
+#ifdef __linux__
+        if (fd >= 0) {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            long long count = 0;
+            if (read(fd, &count, sizeof(count)) == sizeof(count)) return count;
+        }
+#endif
+        return -1;
+    }
+};
+
+// `linesPerTick` is the number of distinct cache lines one robot tick touches, printed as an
+// estimate when hardware counters cannot be read (e.g. inside most VMs and containers).
+template <typename Tick, typename Checksum>
+void bench(const string& label, int ticks, long robots, double linesPerTick, Tick tick, Checksum checksum) {
+    CacheMissCounter misses;
+    misses.start();
+    auto start = chrono::steady_clock::now();
+    for (int t = 0; t < ticks; t++) {
+        tick();
+    }
+    double secs = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    long long missCount = misses.stop();
+    double robotTicks = double(ticks) * robots;
+    cout << "  " << label << " | " << robotTicks / secs / 1e6 << " M robot ticks/s | cache misses ";
+    if (missCount >= 0) {
+        cout << missCount << " (" << missCount / robotTicks << " per robot tick)";
+    } else {
+        cout << "n/a, est. " << linesPerTick << " lines touched per robot tick";
+    }
+    cout << " | checksum " << checksum() << endl;
+}
+
+// --- Main Function ---
+int main() {
+    RobotFleet demo;
+    RobotFleet::RobotId companion = demo.add(Walk::Normal, Talk::Normal, Fly::None, 2);
+    RobotFleet::RobotId worker = demo.add(Walk::None, Talk::None, Fly::Normal, 0);
+    demo.tick();
+    cout << "Companion robot walked " << demo.distanceOf(companion) << ", worker robot flew to "
+         << demo.altitudeOf(worker) << endl;
+
+    const long robots = 1000000;
+    const int ticks = 10;
+
+    mt19937 rng(7);
+    vector<int> kinds(robots), speeds(robots);
+    for (long i = 0; i < robots; i++) {
+        kinds[i] = int(rng() % 8);
+        speeds[i] = int(1 + rng() % 5);
+    }
+
+    // Object graph: every robot and strategy is its own heap allocation. The pointer list is
+    // shuffled to model a fleet built up (and churned) over time rather than all at once.
+    vector<Robot*> graph;
+    graph.reserve(robots);
+    for (long i = 0; i < robots; i++) {
+        int k = kinds[i];
+        Robot* r = new Robot((k & 4) ? static_cast<WalkableRobot*>(new NormalWalk()) : new NoWalk(),
+                             (k & 2) ? static_cast<TalkableRobot*>(new NormalTalk()) : new NoTalk(),
+                             (k & 1) ? static_cast<FlyableRobot*>(new NormalFly()) : new NoFly());
+        r->state.speed = speeds[i];
+        graph.push_back(r);
+    }
+    shuffle(graph.begin(), graph.end(), rng);
+
+    RobotFleet fleet;
+    for (long i = 0; i < robots; i++) {
+        int k = kinds[i];
+        fleet.add((k & 4) ? Walk::Normal : Walk::None, (k & 2) ? Talk::Normal : Talk::None,
+                  (k & 1) ? Fly::Normal : Fly::None, speeds[i]);
+    }
+
+    cout << "\n" << robots << " robots x " << ticks << " ticks:" << endl;
+    // Graph: the Robot, then each of its three strategy objects (vtables stay cached).
+    // Fleet: 20 bytes of robot state spread across five contiguous arrays.
+    bench("object graph + virtual", ticks, robots, 4.0,
+          [&] {
+              for (Robot* r : graph) {
+                  r->walk();
+                  r->talk();
+                  r->fly();
+              }
+          },
+          [&] {
+              int64_t sum = 0;
+              for (Robot* r : graph) {
+                  sum += r->state.distance + r->state.words + r->state.altitude + r->state.battery;
+              }
+              return sum;
+          });
+    bench("SoA fleet, batched    ", ticks, robots, 20.0 / 64, [&] { fleet.tick(); },
+          [&] { return fleet.checksum(); });
+
+    for (Robot* r : graph) {
+        delete r;
+    }
+    return 0;
+}